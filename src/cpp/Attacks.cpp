@@ -0,0 +1,192 @@
+#include "Attacks.hpp"
+#include <vector>
+#include <cassert>
+
+std::array<Attacks::Magic, 64> Attacks::s_rookMagics {};
+std::array<Attacks::Magic, 64> Attacks::s_bishopMagics {};
+std::array<Bitboard, Attacks::s_rookTableSize>   Attacks::s_rookTable {};
+std::array<Bitboard, Attacks::s_bishopTableSize> Attacks::s_bishopTable {};
+std::array<Bitboard, 64> Attacks::s_knightAttacks {};
+std::array<Bitboard, 64> Attacks::s_kingAttacks {};
+std::array<std::array<Bitboard, 64>, 2> Attacks::s_pawnAttacks {};
+std::array<std::array<Bitboard, 64>, 64> Attacks::s_between {};
+std::array<std::array<Bitboard, 64>, 64> Attacks::s_line {};
+
+//The slow way of finding the attacks of a slider. Only used to fill in the tables.
+static Bitboard slidingAttacks(Square const sq, Bitboard const occupied, std::array<Vec2i, 4> const& directions)
+{
+    Bitboard attacks {0};
+    for(auto const direction : directions)
+    {
+        for(Vec2i pos {toChessPos(sq) + direction};
+            pos.x >= 0 && pos.x <= 7 && pos.y >= 0 && pos.y <= 7; pos += direction)
+        {
+            attacks |= squareBB(toSquare(pos));
+
+            if(testSquare(occupied, toSquare(pos)))
+                break;//ran into a blocker
+        }
+    }
+    return attacks;
+}
+
+//The squares reached by stepping once from sq by each of the offsets (the ones that stay on the board).
+template<size_t N>
+static Bitboard leaperAttacks(Square const sq, std::array<Vec2i, N> const& offsets)
+{
+    Bitboard attacks {0};
+    for(auto const offset : offsets)
+    {
+        Vec2i const pos {toChessPos(sq) + offset};
+        if(pos.x >= 0 && pos.x <= 7 && pos.y >= 0 && pos.y <= 7)
+            attacks |= squareBB(toSquare(pos));
+    }
+    return attacks;
+}
+
+//xorshift64* generator used to search for the magic numbers. The seeds are fixed
+//so the same magics (and the same table layout) are found every time the program runs.
+class MagicPRNG
+{
+public:
+    explicit MagicPRNG(uint64_t seed) : mState{seed} {}
+
+    uint64_t next()
+    {
+        mState ^= mState >> 12;
+        mState ^= mState << 25;
+        mState ^= mState >> 27;
+        return mState * 2685821657736338717ull;
+    }
+
+    //Magic numbers with few set bits tend to work better, so AND a few random numbers together.
+    uint64_t nextSparse() {return next() & next() & next();}
+
+private:
+    uint64_t mState;
+};
+
+struct AttackTablesInitializer
+{
+    AttackTablesInitializer()
+    {
+        constexpr std::array<Vec2i, 4> rookDirections   {Vec2i{1, 0}, Vec2i{-1, 0}, Vec2i{0, 1}, Vec2i{0, -1}};
+        constexpr std::array<Vec2i, 4> bishopDirections {Vec2i{1, 1}, Vec2i{-1, 1}, Vec2i{1, -1}, Vec2i{-1, -1}};
+
+        initMagics(Attacks::s_rookMagics, Attacks::s_rookTable.data(),
+            Attacks::s_rookTableSize, rookDirections);
+
+        initMagics(Attacks::s_bishopMagics, Attacks::s_bishopTable.data(),
+            Attacks::s_bishopTableSize, bishopDirections);
+
+        constexpr std::array<Vec2i, 8> knightOffsets {Vec2i{1, 2}, Vec2i{2, 1}, Vec2i{2, -1}, Vec2i{1, -2},
+            Vec2i{-1, -2}, Vec2i{-2, -1}, Vec2i{-2, 1}, Vec2i{-1, 2}};
+        constexpr std::array<Vec2i, 8> kingOffsets {Vec2i{1, 0}, Vec2i{1, 1}, Vec2i{0, 1}, Vec2i{-1, 1},
+            Vec2i{-1, 0}, Vec2i{-1, -1}, Vec2i{0, -1}, Vec2i{1, -1}};
+
+        for(Square sq = 0; sq < 64; ++sq)
+        {
+            Attacks::s_knightAttacks[sq] = leaperAttacks(sq, knightOffsets);
+            Attacks::s_kingAttacks[sq] = leaperAttacks(sq, kingOffsets);
+            Attacks::s_pawnAttacks[0][sq] = leaperAttacks(sq, std::array{Vec2i{-1, 1}, Vec2i{1, 1}});
+            Attacks::s_pawnAttacks[1][sq] = leaperAttacks(sq, std::array{Vec2i{-1, -1}, Vec2i{1, -1}});
+        }
+
+        //uses the slider tables so it has to come after them
+        for(Square a = 0; a < 64; ++a)
+            for(Square b = 0; b < 64; ++b)
+            {
+                Bitboard const bbA {squareBB(a)};
+                Bitboard const bbB {squareBB(b)};
+
+                if(a != b && (Attacks::getRookAttacks(a, 0) & bbB))
+                {
+                    Attacks::s_between[a][b] = Attacks::getRookAttacks(a, bbB) & Attacks::getRookAttacks(b, bbA);
+                    Attacks::s_line[a][b] = (Attacks::getRookAttacks(a, 0) & Attacks::getRookAttacks(b, 0)) | bbA | bbB;
+                }
+                else if(a != b && (Attacks::getBishopAttacks(a, 0) & bbB))
+                {
+                    Attacks::s_between[a][b] = Attacks::getBishopAttacks(a, bbB) & Attacks::getBishopAttacks(b, bbA);
+                    Attacks::s_line[a][b] = (Attacks::getBishopAttacks(a, 0) & Attacks::getBishopAttacks(b, 0)) | bbA | bbB;
+                }
+            }
+    }
+
+    //The "fancy" magic bitboard approach: every square gets a slice of one shared table, sized by
+    //how many squares can block it, and a magic number that maps every blocker configuration to
+    //a unique (or harmlessly shared) index within that slice.
+    static void initMagics(std::array<Attacks::Magic, 64>& magics, Bitboard* const table,
+        [[maybe_unused]] size_t const tableSize, std::array<Vec2i, 4> const& directions)
+    {
+        [[maybe_unused]] constexpr std::array<uint64_t, 8> seeds {728, 10316, 55013, 32803, 12281, 15100, 16645, 255};
+
+        std::vector<Bitboard> occupancies(4096), references(4096);
+        [[maybe_unused]] std::vector<int> epoch(4096, 0);
+        [[maybe_unused]] int attempt {0};
+        size_t tableOffset {0};
+
+        for(Square sq = 0; sq < 64; ++sq)
+        {
+            auto& magic {magics[sq]};
+
+            //Pieces on the edge of the board never block anything (there is nothing behind them),
+            //so leave the edges out of the mask unless sq itself is on that edge.
+            Bitboard const rankOfSq {RANK_1_BB << (8 * (sq / 8))};
+            Bitboard const fileOfSq {FILE_A_BB << (sq % 8)};
+            Bitboard const edges {((RANK_1_BB | RANK_8_BB) & ~rankOfSq) | ((FILE_A_BB | FILE_H_BB) & ~fileOfSq)};
+
+            magic.mask = slidingAttacks(sq, 0, directions) & ~edges;
+            magic.shift = 64 - popCount(magic.mask);
+
+            Bitboard* const slice {table + tableOffset};
+            magic.attacks = slice;
+
+            //Enumerate every subset of the mask (Carry-Rippler trick) along with its attacks.
+            size_t size {0};
+            Bitboard subset {0};
+            do
+            {
+                occupancies[size] = subset;
+                references[size] = slidingAttacks(sq, subset, directions);
+#ifdef CHESS_USE_PEXT
+                slice[magic.index(subset)] = references[size];
+#endif
+                ++size;
+                subset = (subset - magic.mask) & magic.mask;
+            } while(subset);
+
+            tableOffset += size;
+            assert(tableOffset <= tableSize);
+
+#ifndef CHESS_USE_PEXT
+            MagicPRNG rng {seeds[sq / 8]};
+
+            //Keep trying random magics until one maps every subset without a destructive collision.
+            for(size_t i = 0; i < size;)
+            {
+                for(magic.magic = 0; popCount((magic.magic * magic.mask) >> 56) < 6;)
+                    magic.magic = rng.nextSparse();
+
+                //epoch marks which table entries were written during this attempt,
+                //which saves clearing the slice between attempts.
+                for(++attempt, i = 0; i < size; ++i)
+                {
+                    unsigned const idx {magic.index(occupancies[i])};
+
+                    if(epoch[idx] < attempt)
+                    {
+                        epoch[idx] = attempt;
+                        slice[idx] = references[i];
+                    }
+                    else if(slice[idx] != references[i])
+                    {
+                        break;
+                    }
+                }
+            }
+#endif
+        }
+    }
+};
+
+static AttackTablesInitializer const attackTablesInitializer;
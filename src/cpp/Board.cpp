@@ -1,49 +1,38 @@
 #include "Board.hpp"
-#include "SDL.h"
 #include "PieceTypes.hpp"
+#include "MoveGen.hpp"
 #include "ChessEvents.hpp"
 #include "errorLogger.hpp"
-#include "SoundManager.hpp"
+#include "TestPositions.hpp"
 
 #include <string>
 #include <exception>
 #include <fstream>
 #include <cassert>
 #include <ranges>
+#include <algorithm>
 
-static constexpr auto defaultPositionFEN{"rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1"};
-static constexpr auto stalemateTestPositionFEN {"7k/8/8/8/8/8/6q1/K7 b - 0 1"};
-static constexpr auto promotionTestPositionFEN {"rnbqkbnr/ppPppppp/8/8/8/8/PPPPPPpP/RNBQKBNR w KQkq - 0 1"};
-static constexpr auto castleTestPositionFEN{"r3k2r/pppppppp/8/8/8/8/PPPPPPPP/R3K2R w KQkq - 0 1"};
-
-static constexpr auto startingFEN {defaultPositionFEN};
-
-static int chessPos2Index(Vec2i const pos)
-{
-    return pos.y * 8 + pos.x;
-}
-
-static Vec2i index2ChessPos(int const index)
-{
-    return {index % 8, index / 8};
-}
+static constexpr auto startingFEN {TestPositions::defaultPositionFEN};
 
 Board::Board(BoardEventSystem::Publisher const& boardEventPublisher, 
     GUIEventSystem::Subscriber& guiEventSubscriber, 
     NetworkEventSystem::Subscriber& networkEventSubscriber,
-    AppEventSystem::Subscriber& appEventSubscriber)
+    AppEventSystem::Subscriber& appEventSubscriber,
+    EngineEventSystem::Subscriber& engineEventSubscriber)
 
     : mBoardEventPublisher {boardEventPublisher},
       mGuiSubManager{guiEventSubscriber},
       mNetworkSubManager{networkEventSubscriber},
+      mEngineSubManager{engineEventSubscriber},
       mAppEventSubscriber{appEventSubscriber}
 {
     subToEvents();
 
-    loadFENIntoBoard(startingFEN);
-    
-    //update the pieces internal legal moves
-    updateLegalMoves();
+    //enough for any search/perft depth and most games
+    mUndoStack.reserve(256);
+    mHashHistory.reserve(512);
+
+    setPosition(startingFEN);
 }
 
 //Helper function to reduce constructor size.
@@ -68,8 +57,13 @@ void Board::subToEvents()
     [this](Event const& e)
     {
         auto const& evnt { e.unpack<GUIEvents::PromotionEnd>() };
-        mLastMoveMade.promoType = evnt.promoType;
-        postMoveUpdate();
+        if( ! mPendingPromotion )
+            return;
+
+        auto move {*mPendingPromotion};
+        move.promoType = evnt.promoType;
+        mPendingPromotion.reset();
+        commitMove(move);
     });
 
     mNetworkSubManager.sub<NetworkEvents::Unpair>(SubscriptionTypes::UNPAIRED,
@@ -87,20 +81,78 @@ void Board::subToEvents()
     [this](Event const& e)
     {
         auto const& evnt { e.unpack<NetworkEvents::OpponentMadeMove>() };
-        movePiece(evnt.move);
-        postMoveUpdate();
+        onOpponentMove(evnt.move);
+    });
+
+    //a move that couldn't even be decoded goes the same way as an illegal one
+    mNetworkSubManager.sub<NetworkEvents::OpponentSentMalformedMove>(SubscriptionTypes::OPPONENT_SENT_MALFORMED_MOVE,
+    [this](Event const&)
+    {
+        BoardEvents::ProtocolError protocolErrorEvent {ChessMove{}, "the opponent sent a malformed move"};
+        mBoardEventPublisher.pub(protocolErrorEvent);
+    });
+
+    mGuiSubManager.sub<GUIEvents::PlayAgainstEngine>(SubscriptionTypes::PLAY_AGAINST_ENGINE,
+    [this](Event const& e)
+    {
+        auto const engineSide { e.unpack<GUIEvents::PlayAgainstEngine>().engineSide };
+        setSideUserIsPlayingAs(engineSide == Side::WHITE ? Side::BLACK : 
+            engineSide == Side::BLACK ? Side::WHITE : Side::INVALID);
+        resetBoard();
+    });
+
+    mEngineSubManager.sub<EngineEvents::BestMoveFound>(SubscriptionTypes::BEST_MOVE_FOUND,
+    [this](Event const& e)
+    {
+        auto const& evnt { e.unpack<EngineEvents::BestMoveFound>() };
+        commitMove(evnt.move);
     });
 }
 
 void Board::resetBoard()
+{
+    setPosition(startingFEN);
+}
+
+std::expected<void, FENError> Board::setPosition(std::string_view const fen)
+{
+    auto const parsed {FENCodec::parse(fen)};
+    if( ! parsed )
+    {
+        FileErrorLogger::get().log("Error loading the FEN string \"", fen, "\" at character ",
+            parsed.error().position, " (", parsed.error().message, ")");
+        return std::unexpected{parsed.error()};
+    }
+
+    setPosition(fen, *parsed);
+    return {};
+}
+
+void Board::setPosition(std::string_view const fen, FENPosition const& position)
 {
     for(int i = 0; i < 64; ++i) 
-        capturePiece(index2ChessPos(i));
+        capturePiece(toChessPos(i));
 
-    loadFENIntoBoard(startingFEN);
-    setLastCapturedPiece(nullptr);
+    mUndoStack.clear();
+    mPendingPromotion.reset();
+    mPieceOnMouse.reset();
+
+    mStartingFEN = fen;
+    loadFENPosition(position);
+
+    for(Side const side : {Side::WHITE, Side::BLACK})
+    {
+        fillSparePromotionPieces<Queen>(side);
+        fillSparePromotionPieces<Rook>(side);
+        fillSparePromotionPieces<Knight>(side);
+        fillSparePromotionPieces<Bishop>(side);
+    }
+
+    mHashHistory.clear();
+    mHashHistory.push_back(getHash());
+
+    updateCheckState();
     updateLegalMoves();
-    mLastMoveMade = ChessMove{};
 }
 
 //factory method for placing a piece at the specified location on the board
@@ -113,7 +165,9 @@ void Board::makeNewPieceAt(Vec2i const& pos, Side const side)
 
     try
     {
-        m_pieces[chessPos2Index(pos)] = std::make_shared<ConcreteTy>(side, pos);
+        auto& newPiece { m_pieces[toSquare(pos)] };
+        newPiece = std::make_shared<ConcreteTy>(side, pos);
+        mPosition.putPiece(toSquare(pos), PieceCode{side, newPiece->getType()});
     }
     catch(std::bad_alloc const& ba)
     {
@@ -124,305 +178,269 @@ void Board::makeNewPieceAt(Vec2i const& pos, Side const side)
     }
 }
 
-//Loads up a FEN string into the board. 
-//Makes a few assumptions that the given string is a valid FEN string.
-//In the future I will probably make a seperate class for loading the
-//different portions of a fen string; in order to break up this method which is a bit lengthy.
-void Board::loadFENIntoBoard(std::string_view fenString)
+//Replaces the spares taken by promotions played since the last setPosition() that were never taken back.
+template<typename ConcreteTy>
+void Board::fillSparePromotionPieces(Side const side)
 {
-    //Start at the top left (from white's perspective (a8)).
-    int file{0}, rank{7};
-
-    auto it { fenString.cbegin() };
+    ConcreteTy const prototype {side, INVALID_VEC2I};
+    auto& spares {mSparePromotionPieces[static_cast<size_t>(side)][static_cast<size_t>(prototype.getType())]};
 
-    int numWhiteKings{0}, numBlackKings{0};
+    spares.reserve(NUM_SPARE_PROMOTION_PIECES);
+    while(spares.size() < NUM_SPARE_PROMOTION_PIECES)
+        spares.push_back(std::make_shared<ConcreteTy>(side, INVALID_VEC2I));
+}
 
-    //this loop handles the first field (positional field) in the FEN string
-    for(; it != fenString.cend(); ++it)
+static PieceTypes toPieceType(ChessMove::PromoTypes const promoType)
+{
+    switch(promoType)
     {
-        if(*it == ' ')//if the next field was reached
-        {
-            ++it;
-            break;
-        }
-        if(*it == '/')
-        {
-            --rank;
-            file = 0;
-        }
-        else if(isdigit(*it))
-        {
-            //ascii digit - 48 maps the char to the cooresponding decimal value
-            file += *it - 48;
-        }
-        else//If the char pointed to by "it" is an upper or lower case letter.
-        {
-            Side side = isupper(*it) ? Side::WHITE : Side::BLACK;
-
-            switch(tolower(*it))
-            {
-            case 'p': makeNewPieceAt<Pawn>  ({file, rank}, side); break;
-            case 'n': makeNewPieceAt<Knight>({file, rank}, side); break;
-            case 'r': makeNewPieceAt<Rook>  ({file, rank}, side); break;
-            case 'b': makeNewPieceAt<Bishop>({file, rank}, side); break;
-            case 'q': makeNewPieceAt<Queen> ({file, rank}, side); break;
-            case 'k':
-            {
-                makeNewPieceAt<King>({file, rank}, side);
-                if(side == Side::WHITE) ++numWhiteKings;
-                else ++numBlackKings;
-            }
-            }
-            ++file;
-        }
+    case ChessMove::PromoTypes::QUEEN:  return PieceTypes::QUEEN;
+    case ChessMove::PromoTypes::ROOK:   return PieceTypes::ROOK;
+    case ChessMove::PromoTypes::KNIGHT: return PieceTypes::KNIGHT;
+    default:                            return PieceTypes::BISHOP;
     }
+}
 
-    if(numBlackKings != 1)
-        FileErrorLogger::get().log("Error loading the FEN string (incorrect num of black kings)");
-
-    if(numWhiteKings != 1)
-        FileErrorLogger::get().log("Error loading the FEN string (incorrect num of white kings)");
-
-    //if the FEN string only had a positional field
-    if(it == fenString.cend())
-        return;
-
-    //Handle who's turn it is to move.
-    //If c is 'w' then it's whites turn otherwise it's blacks turn.
-    mWhiteOrBlacksTurn = (*it == 'w') ? Side::WHITE : Side::BLACK;
-
-    //If the turn field wasn't the last field, then jump over the space after it.
-    if(++it != fenString.cend())
-        ++it;
-    else return;
-
-    //handle castling rights
-    const Vec2i a1{0, 0}, a8{0, 7}, h1{7, 0}, h8{7, 7};
-    for(; it != fenString.cend(); ++it)
+void Board::loadFENPosition(FENPosition const& fen)
+{
+    for(Square sq = 0; sq < 64; ++sq)
     {
-        if(*it == ' ')
-            break;
+        PieceCode const code {fen.position.pieceAt(sq)};
+        Vec2i const chessPos {toChessPos(sq)};
 
-        switch(*it)
+        switch(code.getType())
         {
-        case 'K'://if the FEN string has white king side castling encoded into it
-        {   
-            auto const unmovedRook = std::dynamic_pointer_cast<Rook>(getPieceAt(h1));
-            assert(unmovedRook);//if white can castle short there should be a rook on h1
-            unmovedRook->setKingOrQueenSide(Rook::KingOrQueenSide::KING_SIDE);
-            m_castlingRights.addRights(CastleRights::Rights::WSHORT);
-            break;
-        }
-        case 'Q':
-        {
-            auto const unmovedRook = std::dynamic_pointer_cast<Rook>(getPieceAt(a1));
-            assert(unmovedRook);//if white can castle long there should be a rook on a1
-            unmovedRook->setKingOrQueenSide(Rook::KingOrQueenSide::QUEEN_SIDE);
-            m_castlingRights.addRights(CastleRights::Rights::WLONG);
-            break;
-        }
-        case 'k':
-        {   
-            auto const unmovedRook = std::dynamic_pointer_cast<Rook>(getPieceAt(h8));
-            assert(unmovedRook);//if black can castle short there should be a rook on h8
-            unmovedRook->setKingOrQueenSide(Rook::KingOrQueenSide::KING_SIDE);
-            m_castlingRights.addRights(CastleRights::Rights::BSHORT);
-            break;
-        }
-        case 'q':
-        {   
-            auto const unmovedRook = std::dynamic_pointer_cast<Rook>(getPieceAt(a8));
-            assert(unmovedRook);//if black can castle long there should be a rook on a8
-            unmovedRook->setKingOrQueenSide(Rook::KingOrQueenSide::QUEEN_SIDE);
-            m_castlingRights.addRights(CastleRights::Rights::BLONG);
-        }
+        case PieceTypes::PAWN:   makeNewPieceAt<Pawn>  (chessPos, code.getSide()); break;
+        case PieceTypes::KNIGHT: makeNewPieceAt<Knight>(chessPos, code.getSide()); break;
+        case PieceTypes::ROOK:   makeNewPieceAt<Rook>  (chessPos, code.getSide()); break;
+        case PieceTypes::BISHOP: makeNewPieceAt<Bishop>(chessPos, code.getSide()); break;
+        case PieceTypes::QUEEN:  makeNewPieceAt<Queen> (chessPos, code.getSide()); break;
+        case PieceTypes::KING:   makeNewPieceAt<King>  (chessPos, code.getSide()); break;
+        default: break;
         }
     }
 
-    //if the castle rights field wasnt the last field then jump over the space after it
-    if(it != fenString.cend())
-        ++it;
-    else return;
+    mWhiteOrBlacksTurn = fen.sideToMove;
+    m_castlingRights = fen.castleRights;
+    mEnPassantLocation = fen.enPassantSquare == INVALID_SQUARE ? INVALID_VEC2I : toChessPos(fen.enPassantSquare);
+    mHalfmoveClock = fen.halfmoveClock;
+    mFullmoveNumber = fen.fullmoveNumber;
+}
 
-    //handle possible en passant target
-    if(*it != '-')
+FENPosition Board::getFENPosition() const
+{
+    return FENPosition
     {
-        char c = tolower(*it);
-        int file = c - 'a';//map lowcase ascii to 0-26
-        ++it;
-        int rank = *it - 48;
-        --rank;//rank and file start from zero so decrement is needed here
-        mEnPassantLocation = {file, rank};
-    }
-    else mEnPassantLocation = INVALID_VEC2I;
+        .position = mPosition,
+        .sideToMove = mWhiteOrBlacksTurn,
+        .castleRights = m_castlingRights,
+        .enPassantSquare = isEnPassantAvailable() ? toSquare(mEnPassantLocation) : INVALID_SQUARE,
+        .halfmoveClock = mHalfmoveClock,
+        .fullmoveNumber = mFullmoveNumber
+    };
+}
 
-    //if the FEN string doesnt have the last two fields
-    if(it == fenString.cend())
-        return;
+std::string Board::getFEN() const
+{
+    std::array<char, FENCodec::MAX_LENGTH> buffer;
+    return std::string{FENCodec::write(getFENPosition(), buffer)};
 }
 
-void Board::pickUpPiece(Vec2i const chessPos) const
+void Board::pickUpPiece(Vec2i const chessPos)
 {
-    if(Piece::getPieceOnMouse())
+    if(mPieceOnMouse)
         return;
 
     auto const p { getPieceAt(chessPos) };
     if(p && p->getSide() == getWhosTurnItIs())
-        Piece::setPieceOnMouse(p);
+        mPieceOnMouse = p;
 }
 
-//called from piecePutDownRoutine() to see if the move being requested
-//is in the vector of fully legal moves for the piece on the mouse
-auto Board::requestMove(Vec2i const& destinationSquare)
+//called from putPieceDown() to see if the move being requested is one of
+//the legal moves for the piece on the mouse. std::nullopt if it isn't.
+std::optional<ChessMove> Board::requestMove(Vec2i const& destinationSquare) const
 {
-    auto pom { Piece::getPieceOnMouse() };
+    Square const from { toSquare(mPieceOnMouse->getChessPosition()) };
+    Square const to { toSquare(destinationSquare) };
 
-    auto end { pom->getLegalMoves().end() };
-    for(auto it = pom->getLegalMoves().begin(); it != end; ++it)
-    {
-        if(it->dest == destinationSquare)
-            return it;
-    }
+    //a promotion is listed once per piece, but the first one is enough since the user picks the piece afterwards
+    auto const it { std::ranges::find_if(mLegalMoves, [from, to](PackedMove const move)
+        { return move.getFrom() == from && move.getTo() == to; }) };
+
+    if(it == mLegalMoves.end())
+        return std::nullopt;
 
-    return end;
+    return it->toChessMove();
 }
 
 void Board::putPieceDown(Vec2i const chessPos)
 {
-    auto const pom {Piece::getPieceOnMouse()};
+    auto const pom {mPieceOnMouse};
     if( ! pom ) { return; }
     
     if( ! isValidChessPosition(chessPos) )
     {
         //Put the piece being held by the mouse back down from where it was picked up.
-        Piece::resetPieceOnMouse();
+        mPieceOnMouse.reset();
         return;
     }
 
-    if(auto it {requestMove(chessPos)}; it != pom->getLegalMoves().end())
+    if(auto const requestedMove {requestMove(chessPos)})
     {
-        movePiece(*it);
+        auto const move {*requestedMove};
+        mPieceOnMouse.reset();
 
-        if(ChessMove::MoveTypes::PROMOTION == it->moveType)
+        if(ChessMove::MoveTypes::PROMOTION == move.moveType)
         {
-            BoardEvents::PromotionBegin evnt{getWhosTurnItIs(), it->dest};
+            //Don't make the move yet. Wait for the user to select a peice from the 
+            //promotion popup first. Then there will be enough information to call commitMove().
+            mPendingPromotion = move;
+            BoardEvents::PromotionBegin evnt{getWhosTurnItIs(), move.dest};
             mBoardEventPublisher.pub(evnt);
-
-            Piece::resetPieceOnMouse();
-
-            //Return and do the post move update yet. Wait for the user to select a peice from the 
-            //promotion popup first. Then there will be enough information to call postMoveUpdate().
             return;
         }
 
-        postMoveUpdate();
+        commitMove(move);
+        return;
     }
 
-    Piece::resetPieceOnMouse();
+    mPieceOnMouse.reset();
 }
 
 std::shared_ptr<Piece> Board::getPieceAt(Vec2i const& chessPos) const&
 {
-    return m_pieces[chessPos2Index(chessPos)];
+    return m_pieces[toSquare(chessPos)];
 }
 
-void Board::handleDoublePushMove()
+void Board::makeMove(PackedMove const move)
 {
-    Vec2i const newEnPassantTarget
-    {
-        mLastMoveMade.dest.x, 
-        mLastMoveMade.dest.y == 3 ? 2 : 5
-    };
+    auto& undo {mUndoStack.emplace_back()};
+    undo.move = move;
+    undo.castlingRights = m_castlingRights;
+    undo.enPassantLocation = mEnPassantLocation;
+    undo.checkers = mCheckers;
+    undo.pinned = mPinned;
+    undo.halfmoveClock = mHalfmoveClock;
 
-    updateEnPassant(newEnPassantTarget);
-}
+    Square const from {move.getFrom()};
+    Square const to {move.getTo()};
 
-void Board::handleCastleMove()
-{   
-    //the king is on the castlesquare but the rook has yet to be moved
+    //captures and pawn moves can't be undone over the board, so they restart the halfmove clock
+    bool const isPawnMove {mPosition.pieceAt(from).getType() == PieceTypes::PAWN};
 
-    bool const wasLongCastle = mLastMoveMade.dest.x == 2;
+    //The pawn taken by an en passant capture is beside the destination square (on the rank the capturing pawn came from).
+    Square const capturedAt {move.isEnPassant() ? (from & ~7) | (to & 7) : to};
 
-    //where is the rook (before we put it on the other side of the king)
-    Vec2i const preCastleRookPos
+    if(auto& captured {m_pieces[capturedAt]})
     {
-        wasLongCastle ? (mLastMoveMade.dest.x - 2) : (mLastMoveMade.dest.x + 1),
-        mLastMoveMade.dest.y
-    };
+        undo.capturedPiece = std::move(captured);
+        mPosition.removePiece(capturedAt);
+    }
 
-    auto rookToBeMoved = getPieceAt(preCastleRookPos);
-    bool wasRookWhite = rookToBeMoved->getSide() == Side::WHITE;
+    mHalfmoveClock = (isPawnMove || undo.capturedPiece) ? 0 : mHalfmoveClock + 1;
+    if(getWhosTurnItIs() == Side::BLACK)
+        ++mFullmoveNumber;
 
-    Vec2i const postCastleRookPos
-    {
-        mLastMoveMade.dest.x + (wasLongCastle ? 1 : -1),
-        mLastMoveMade.dest.y
-    };
+    movePiece(from, to);
 
-    //Move the rook to the other side of the king.
-    movePiece(ChessMove{preCastleRookPos, postCastleRookPos, false, ChessMove::MoveTypes::CASTLE});
-    
-    m_castlingRights.revokeRights(wasRookWhite ? Side::WHITE : Side::BLACK);
-}
+    resetEnPassant();
+    m_castlingRights.revokeRights(move.getRightsToRevoke());
 
-void Board::handleEnPassantMove()
-{
-    Vec2i const enPassantSquare = getEnPassantLocation();
-    Vec2i const doublePushedPawnPosition
+    if(move.isDoublePush())
     {
-        enPassantSquare.x, 
-        enPassantSquare.y == 2 ? 3 : 4
-    };
+        //the square the pawn skipped over
+        updateEnPassant(toChessPos((from + to) / 2));
+    }
+    else if(move.isCastle())
+    {
+        //the king is on the castle square but the rook has yet to be moved to the other side of it
+        bool const wasLongCastle {to < from};
+        movePiece(wasLongCastle ? to - 2 : to + 1, wasLongCastle ? to + 1 : to - 1);
+    }
+    else if(move.isPromotion())
+    {
+        //Take the pawn off the board (keeping it for unmakeMove()) and put one of the spare pieces in its place.
+        undo.promotedPawn = std::move(m_pieces[to]);
+        mPosition.removePiece(to);
+
+        Side const whosTurn {getWhosTurnItIs()};
+        PieceTypes const type {toPieceType(move.getPromoType())};
+        auto& spares {mSparePromotionPieces[static_cast<size_t>(whosTurn)][static_cast<size_t>(type)]};
+        assert( ! spares.empty() );
+
+        auto& promoted {m_pieces[to]};
+        promoted = std::move(spares.back());
+        spares.pop_back();
+        promoted->setChessPosition(toChessPos(to));
+        mPosition.putPiece(to, PieceCode{whosTurn, type});
+    }
 
-    capturePiece(doublePushedPawnPosition);
+    toggleTurn();
+    mHashHistory.push_back(getHash());
+    updateCheckState();
 }
 
-//called after movePiece()
-void Board::postMoveUpdate()
+void Board::unmakeMove()
 {
-    auto move {mLastMoveMade};
+    assert( ! mUndoStack.empty() );
+    auto& undo {mUndoStack.back()};
+    auto const move {undo.move};
+    Square const from {move.getFrom()};
+    Square const to {move.getTo()};
 
-    m_castlingRights.revokeRights(move.rightsToRevoke);
+    toggleTurn();
 
-    switch(move.moveType)
+    if(undo.promotedPawn)
     {
-    case ChessMove::MoveTypes::DOUBLE_PUSH:   { handleDoublePushMove(); break; }
-    case ChessMove::MoveTypes::ENPASSANT:     { handleEnPassantMove();  break; }
-    case ChessMove::MoveTypes::CASTLE:        { handleCastleMove();     break; }
-    case ChessMove::MoveTypes::PROMOTION: 
+        //the promoted piece goes back to the spares
+        auto& promoted {m_pieces[to]};
+        mSparePromotionPieces[static_cast<size_t>(promoted->getSide())][static_cast<size_t>(promoted->getType())]
+            .push_back(std::move(promoted));
+        mPosition.removePiece(to);
+
+        mPosition.putPiece(to, PieceCode{undo.promotedPawn->getSide(), PieceTypes::PAWN});
+        m_pieces[to] = std::move(undo.promotedPawn);
+    }
+
+    if(move.isCastle())
     {
-        capturePiece(move.dest);//capture the pawn before we make the new piece
+        bool const wasLongCastle {to < from};
+        movePiece(wasLongCastle ? to + 1 : to - 1, wasLongCastle ? to - 2 : to + 1);
+    }
 
-        auto const& pType {move.promoType};//shorter name
+    movePiece(to, from);
 
-        assert(pType != ChessMove::PromoTypes::INVALID);
+    if(undo.capturedPiece)
+    {
+        Square const capturedAt {toSquare(undo.capturedPiece->getChessPosition())};
+        mPosition.putPiece(capturedAt, PieceCode{undo.capturedPiece->getSide(), undo.capturedPiece->getType()});
+        m_pieces[capturedAt] = std::move(undo.capturedPiece);
+    }
 
-        auto const whosTurn = getWhosTurnItIs();
+    m_castlingRights = undo.castlingRights;
+    mEnPassantLocation = undo.enPassantLocation;
+    mCheckers = undo.checkers;
+    mPinned = undo.pinned;
+    mHalfmoveClock = undo.halfmoveClock;
+    if(getWhosTurnItIs() == Side::BLACK)
+        --mFullmoveNumber;
 
-        if(pType == ChessMove::PromoTypes::QUEEN) makeNewPieceAt<Queen>(move.dest, whosTurn);
-        else if(pType == ChessMove::PromoTypes::ROOK) makeNewPieceAt<Rook>(move.dest, whosTurn);
-        else if(pType == ChessMove::PromoTypes::KNIGHT) makeNewPieceAt<Knight>(move.dest, whosTurn);
-        else /*if pType is a bishop promotion*/ makeNewPieceAt<Bishop>(move.dest, whosTurn);
+    mHashHistory.pop_back();
+    mUndoStack.pop_back();
+}
 
-        Piece::resetPieceOnMouse();
-        break;
-    }
-    }
+void Board::commitMove(ChessMove move)
+{
+    move.wasOpponentsMove = getSideUserIsPlayingAs() != getWhosTurnItIs();
 
-    if(move.moveType != ChessMove::MoveTypes::DOUBLE_PUSH)
-        resetEnPassant();
+    makeMove(PackedMove{move});
+    updateLegalMoves();
 
     {
-        bool const wasOpponentsMove {getSideUserIsPlayingAs() != getWhosTurnItIs()};
-        move.wasOpponentsMove = wasOpponentsMove;
         BoardEvents::MoveCompleted moveCompletedEvent{move};
         mBoardEventPublisher.pub(moveCompletedEvent);
     }
 
-    toggleTurn();
-    setLastCapturedPiece(nullptr);
-    updateLegalMoves();
-
     //Determine if the last move caused a checkmate/stalemate.
     //std::nullopt means no check/stalemate has occurred.
     if(auto maybeCheckOrStaleMate{hasCheckOrStalemateOccurred()})
@@ -435,21 +453,64 @@ void Board::postMoveUpdate()
         BoardEvents::GameOver gameOverEvent {std::move(gameOverReason)};
         mBoardEventPublisher.pub(gameOverEvent);
     }
+    //There is no way for a player to claim a draw, so the claimable draws (threefold repetition and
+    //the fifty move rule) end the game straight away just like the seventy-five move rule does.
+    //A checkmate on the move that reaches the limit still counts, so it is checked first.
+    else if(auto maybeDraw{hasDrawByRuleOccurred()})
+    {
+        std::string gameOverReason {*maybeDraw == DrawTypes::THREEFOLD_REPETITION ? 
+            "Draw by threefold repetition" : *maybeDraw == DrawTypes::FIFTY_MOVE_RULE ? 
+            "Draw by the fifty move rule" : "Draw by the seventy-five move rule"};
+
+        BoardEvents::GameOver gameOverEvent {std::move(gameOverReason)};
+        mBoardEventPublisher.pub(gameOverEvent);
+    }
 }
 
-//std::nullopt means no check/stalemate has occurred.
-std::optional<Board::MateTypes> Board::hasCheckOrStalemateOccurred()
+//std::nullopt means the game hasn't been drawn by repetition or by the 50/75 move rules.
+std::optional<Board::DrawTypes> Board::hasDrawByRuleOccurred() const
 {
-    //if there are any legal moves for getWhosTurnItIs() side then there has not been a check/slate mate yet
-    for(auto const& p : m_pieces)
+    //the clock counts half moves so 100 is fifty moves by each side
+    if(mHalfmoveClock >= 150)
+        return DrawTypes::SEVENTY_FIVE_MOVE_RULE;
+
+    if(mHalfmoveClock >= 100)
+        return DrawTypes::FIFTY_MOVE_RULE;
+
+    if(getRepetitionCount() >= 3)
+        return DrawTypes::THREEFOLD_REPETITION;
+
+    return std::nullopt;
+}
+
+int Board::getRepetitionCount() const
+{
+    assert( ! mHashHistory.empty() );
+
+    //A position can only repeat with the same side to move, so every other position is skipped.
+    //Nothing before the last capture or pawn move can match, and the fifty move rule ends the
+    //game once the halfmove clock reaches 100, so this looks at no more than 50 hashes per move.
+    auto const current {mHashHistory.back()};
+    auto const lastIndex {static_cast<int>(mHashHistory.size()) - 1};
+    auto const firstIndex {std::max(0, lastIndex - mHalfmoveClock)};
+
+    int count {1};
+    for(int i = lastIndex - 2; i >= firstIndex; i -= 2)
     {
-        if(p && p->getSide() == getWhosTurnItIs())
-        {
-            if(p->getLegalMoves().size() > 0)
-                return std::nullopt;
-        }
+        if(mHashHistory[static_cast<size_t>(i)] == current)
+            ++count;
     }
 
+    return count;
+}
+
+//std::nullopt means no check/stalemate has occurred.
+std::optional<Board::MateTypes> Board::hasCheckOrStalemateOccurred() const
+{
+    //if there are any legal moves for getWhosTurnItIs() side then there has not been a check/slate mate yet
+    if( ! mLegalMoves.empty() )
+        return std::nullopt;
+
     //else if there are no legal moves for the other side...
     
     auto const cs = getCheckState();
@@ -465,6 +526,11 @@ std::optional<Board::MateTypes> Board::hasCheckOrStalemateOccurred()
     return ret;
 }
 
+void Board::generateLegalMoves(MoveList& out) const
+{
+    MoveGen::generateLegalMoves(*this, out);
+}
+
 void Board::updateEnPassant(Vec2i const newLocation)
 {
     mEnPassantLocation = isValidChessPosition(newLocation) ? newLocation : INVALID_VEC2I;
@@ -475,131 +541,98 @@ void Board::toggleTurn()
     mWhiteOrBlacksTurn = mWhiteOrBlacksTurn == Side::WHITE ? Side::BLACK : Side::WHITE;
 }
 
-//update the pieces m_pseudoLegals and m_attackedSquares
-void Board::updatePseudoLegalsAndAttackedSquares()
+void Board::updateCheckState()
 {
-    for(auto const& p : m_pieces)
-    {   
-        if(p)
-        {
-            //since the below method is two methods in one for DRY reasons,
-            //its easier to just update both sides every move. This is basically
-            //the same amount of work as updating the side that just moved attacked squares,
-            //then the side that is about to move psuedo legal moves since it has to do the same
-            //work for both of those at once.
-            p->updatePseudoLegalAndAttacked(*this);
-        }
-    }
+    mCheckers = 0;
+    mPinned = 0;
+
+    Square const kingSq {mPosition.getKingSquare(mWhiteOrBlacksTurn)};
+    if(kingSq == INVALID_SQUARE)
+        return;
+
+    Side const opponent {mWhiteOrBlacksTurn == Side::WHITE ? Side::BLACK : Side::WHITE};
+    mCheckers = MoveGen::getAttackersTo(mPosition, kingSq, opponent, mPosition.getOccupied());
+    mPinned = MoveGen::getPinnedPieces(mPosition, mWhiteOrBlacksTurn);
 }
 
-std::vector<Vec2i> Board::getAttackedSquares(Side side) const
+Board::CheckType Board::getCheckState() const
 {
-    std::vector<Vec2i> ret;
-    for(auto const& p : m_pieces)
+    switch(popCount(mCheckers))
     {
-        if(p && side == p->getSide())
-        {
-            auto const cbegin { p->getAttackedSquares().cbegin() };
-            auto const cend { p->getAttackedSquares().cend() };
-            ret.insert(ret.cend(), cbegin, cend);
-        }
+    case 0:  return CheckType::NO_CHECK;
+    case 1:  return CheckType::SINGLE_CHECK;
+    default: return CheckType::DOUBLE_CHECK;
     }
-    return ret;
 }
 
-//calculate all the pinned pieces for the side that is about to move (toggleTurn() should have already been called)
-//returns a vector or pairs where the first piece* is the pinned piece and the other is the pinning piece
-void Board::updatePinnedPieces()
+Vec2i Board::getLocationOfCheckingPiece() const
 {
-    for(auto const& p : m_pieces)
-    {
-        if(!p) continue;
+    return mCheckers ? toChessPos(lsb(mCheckers)) : INVALID_VEC2I;
+}
 
-        //this function only needs update the pieces for the side that is about to move
-        if(p->getSide() != mWhiteOrBlacksTurn) continue;
-        
-        p->updatePinnedInfo(*this);
-    }
+//The promotion piece bits are left out of the flags in the isLegalMove() tables.
+static uint8_t getFlagsWithoutPromoPiece(PackedMove const move)
+{
+    return move.isPromotion() ? move.getFlags() & ~0b11 : move.getFlags();
 }
 
-void Board::updateCheckState()
+void Board::updateLegalMoves()
 {
-    mCurrentCheckType = CheckType::NO_CHECK;
-    mCheckingPieceLocation = INVALID_VEC2I;
-    auto const kingPos
-    {
-        mWhiteOrBlacksTurn == Side::WHITE ?
-        King::getWhiteKingPos() :
-        King::getBlackKingPos()
-    };
-    
-    for(auto const& p : m_pieces)
+    generateLegalMoves(mLegalMoves);
+
+    mLegalDestinations.fill(0);
+    for(auto const move : mLegalMoves)
     {
-        if(p && p->getSide() != mWhiteOrBlacksTurn)
-        {
-            auto const cbegin { p->getAttackedSquares().cbegin() };
-            auto const cend   { p->getAttackedSquares().cend() };
-            if(std::find(cbegin, cend, kingPos) != cend)
-            {
-                if(mCurrentCheckType == CheckType::SINGLE_CHECK)
-                {
-                    mCurrentCheckType = CheckType::DOUBLE_CHECK;
-                    return;
-                }
-                
-                mCurrentCheckType = CheckType::SINGLE_CHECK;
-                mCheckingPieceLocation = p->getChessPosition();
-            }
-        }
+        mLegalDestinations[move.getFrom()] |= squareBB(move.getTo());
+        mLegalMoveFlags[move.getFrom()][move.getTo()] = getFlagsWithoutPromoPiece(move);
     }
 }
 
-void Board::updateLegalMoves()
+bool Board::isLegalMove(PackedMove const move) const
 {
-    //1) update all of the piece's psuedo legal moves and attacked squares
-    updatePseudoLegalsAndAttackedSquares();
+    return testSquare(mLegalDestinations[move.getFrom()], move.getTo()) &&
+        mLegalMoveFlags[move.getFrom()][move.getTo()] == getFlagsWithoutPromoPiece(move);
+}
 
-    //2) after we know which squares are being attacked
-    //   and the updated pseudo legal moves. We can determine
-    //   if the king is in check.
-    updateCheckState();
+//Nothing the opponent sends is trusted. A move that isn't legal here means the two boards
+//no longer agree (or the opponent is cheating), so it is reported instead of played.
+void Board::onOpponentMove(ChessMove const& move)
+{
+    char const* error {nullptr};
 
-    //3) now update all of the pieces Piece::m_locationOfPiecePinningThis
-    updatePinnedPieces();
+    if(getWhosTurnItIs() == getSideUserIsPlayingAs())
+        error = "the opponent moved on the user's turn";
+    else if(isGameOver())
+        error = "the opponent moved after the game was over";
+    else if( ! isLegalMove(PackedMove{move}) )
+        error = "the opponent sent an illegal move";
 
-    //4) now that all of the pieces pseudo legal moves, attacked 
-    //   squares, pinned pieces, and m_checkState are up to 
-    //   date we can calculate the fully legal moves
-    for(auto const& p : m_pieces)
+    if(error)
     {
-        if(p && p->getSide() == mWhiteOrBlacksTurn)
-            p->updateLegalMoves(*this);
+        BoardEvents::ProtocolError protocolErrorEvent {move, error};
+        mBoardEventPublisher.pub(protocolErrorEvent);
+        return;
     }
+
+    commitMove(move);
 }
 
 void Board::capturePiece(Vec2i location)
 {  
     assert(isValidChessPosition(location));
-    m_lastCapturedPiece = getPieceAt(location);
-    m_pieces[chessPos2Index(location)].reset();
+    m_pieces[toSquare(location)].reset();
+    mPosition.removePiece(toSquare(location));
 }
 
-//all piece moves should go through this method
-void Board::movePiece(ChessMove const& move)
+//Moves the piece on src to dest keeping m_pieces and mPosition in sync. dest must be empty.
+void Board::movePiece(Square const src, Square const dest)
 {   
-    //if there is a piece at the destination move it to the array of captured pieces
-    if(getPieceAt(move.dest))
-        capturePiece(move.dest);
-
-    auto const destIdx   {chessPos2Index(move.dest)};
-    auto const sourceIdx {chessPos2Index(move.src)};
+    assert(m_pieces[src] && ! m_pieces[dest]);
 
-    m_pieces[destIdx] = m_pieces[sourceIdx];
-    m_pieces[sourceIdx].reset();
+    m_pieces[dest] = std::move(m_pieces[src]);
+    mPosition.movePiece(src, dest);
 
-    m_pieces[destIdx]->setChessPosition(move.dest);
-
-    mLastMoveMade = move;
+    m_pieces[dest]->setChessPosition(toChessPos(dest));
 }
 
 //tells if a chess position is on the board or not
@@ -608,6 +641,21 @@ bool Board::isValidChessPosition(Vec2i chessPos)
     return chessPos.x <= 7 && chessPos.x >= 0 && chessPos.y <= 7 && chessPos.y >= 0;
 }
 
+uint64_t Board::getHash() const
+{
+    uint64_t hash {mPosition.getPiecesHash() ^ Zobrist::getCastleRightsKey(m_castlingRights.getRights())};
+
+    if(mWhiteOrBlacksTurn == Side::BLACK)
+        hash ^= Zobrist::getBlackToMoveKey();
+
+    //Only when the capture can actually be made. Otherwise the position is the same as it would be without the
+    //en passant square (for repetitions and the transposition table) and has to hash the same.
+    if(isEnPassantAvailable() && MoveGen::canCaptureEnPassant(mPosition, mWhiteOrBlacksTurn, toSquare(mEnPassantLocation)))
+        hash ^= Zobrist::getEnPassantKey(mEnPassantLocation.x);
+
+    return hash;
+}
+
 bool Board::hasCastleRights(CastleRights::Rights rights) const
 {
     return m_castlingRights.hasRights(rights);
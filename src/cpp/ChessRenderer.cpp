@@ -331,6 +331,27 @@ float ChessRenderer::drawMenuBar(Board const& b, ConnectionManager const& cm)
             if(ImGui::MenuItem("connect to another player", nullptr, nullptr))
                 mIsConnectionWindowOpen = true;
 
+            //the computer can't be played while paired with someone online
+            if( ! cm.isPairedOnline() )
+            {
+                std::optional<Side> engineSide {std::nullopt};
+
+                if(ImGui::MenuItem("play the computer as white", nullptr, nullptr)) engineSide = Side::BLACK;
+                if(ImGui::MenuItem("play the computer as black", nullptr, nullptr)) engineSide = Side::WHITE;
+                if(ImGui::MenuItem("stop playing the computer", nullptr, nullptr))  engineSide = Side::INVALID;
+
+                if(engineSide)
+                {
+                    mIsPromotionWindowOpen = false;
+                    mViewingPerspective = *engineSide == Side::WHITE ? Side::BLACK : Side::WHITE;
+
+                    GUIEvents::PlayAgainstEngine evnt {*engineSide};
+                    mGuiEventPublisher.pub(evnt);
+
+                    clearArrows();
+                }
+            }
+
             ImGui::EndMenu();
         }
 
@@ -435,9 +456,27 @@ float ChessRenderer::drawMenuBar(Board const& b, ConnectionManager const& cm)
     return menuBarHeight;
 }
 
+//Which of the piece textures to draw for a piece (the pieces themselves dont know anything about textures).
+static TextureManager::WhichTexture getPieceTexture(Piece const& piece)
+{
+    using enum TextureManager::WhichTexture;
+    bool const isWhite {piece.getSide() == Side::WHITE};
+
+    switch(piece.getType())
+    {
+    case PieceTypes::PAWN:   return isWhite ? WHITE_PAWN   : BLACK_PAWN;
+    case PieceTypes::KNIGHT: return isWhite ? WHITE_KNIGHT : BLACK_KNIGHT;
+    case PieceTypes::ROOK:   return isWhite ? WHITE_ROOK   : BLACK_ROOK;
+    case PieceTypes::BISHOP: return isWhite ? WHITE_BISHOP : BLACK_BISHOP;
+    case PieceTypes::QUEEN:  return isWhite ? WHITE_QUEEN  : BLACK_QUEEN;
+    case PieceTypes::KING:   return isWhite ? WHITE_KING   : BLACK_KING;
+    default: return INVALID;
+    }
+}
+
 void ChessRenderer::drawPiecesNotOnMouse(Board const& b)
 {
-    auto const pom { Piece::getPieceOnMouse() };
+    auto const pom { b.getPieceOnMouse() };
 
     for(auto const& piece : b.getPieces())
     {
@@ -452,7 +491,7 @@ void ChessRenderer::drawPiecesNotOnMouse(Board const& b)
             screenPosition.x -= mBoardPos.x;
             screenPosition.y -= mBoardPos.y;
 
-            auto const& texture { mTextureManager.getTexture(piece->getWhichTexture()) };
+            auto const& texture { mTextureManager.getTexture(getPieceTexture(*piece)) };
 
             //get the width and height of whichever texture the piece on the mouse is
             Vec2i textureSize { texture.getSize() };
@@ -471,13 +510,13 @@ void ChessRenderer::drawPiecesNotOnMouse(Board const& b)
     }
 }
 
-void ChessRenderer::drawPieceOnMouse()
+void ChessRenderer::drawPieceOnMouse(Board const& b)
 {
-    auto const pom { Piece::getPieceOnMouse() };
+    auto const pom { b.getPieceOnMouse() };
 
     if(pom)
     {
-        auto const& pieceTex { mTextureManager.getTexture(pom->getWhichTexture()) };
+        auto const& pieceTex { mTextureManager.getTexture(getPieceTexture(*pom)) };
         auto const pieceTexSize { pieceTex.getSize() * mBoardScalingFactor };
         auto const texSizeHalfX = pieceTexSize.x / 2;
         auto const texSizeHalfY = pieceTexSize.y / 2;
@@ -492,7 +531,7 @@ void ChessRenderer::drawPieceOnMouse()
 
 void ChessRenderer::drawMoveIndicatorCircles(Board const& b)
 {
-    auto const pom = Piece::getPieceOnMouse();
+    auto const pom = b.getPieceOnMouse();
     if( ! pom ) return;
 
     auto* const wdl { ImGui::GetWindowDrawList() };
@@ -501,12 +540,17 @@ void ChessRenderer::drawMoveIndicatorCircles(Board const& b)
     ImU32 const greyColor { ImGui::GetColorU32( {.33f, .33f, .33f, .65f} ) };
     int const segmentCount { 40 };
 
-    for(auto const& move : pom->getLegalMoves())
+    for(auto const move : b.getLegalMoves())
     {
-        ImVec2 const circlePos { chess2ScreenPos(move.dest) };
+        //promotions are listed once per piece, so only draw the queen promotion's circle
+        if(move.getFrom() != toSquare(pom->getChessPosition()) || 
+           (move.isPromotion() && move.getPromoType() != ChessMove::PromoTypes::QUEEN))
+            continue;
+
+        ImVec2 const circlePos { chess2ScreenPos(toChessPos(move.getTo())) };
 
         //If this legal move is a capture of another piece draw a red circle, otherwise draw a gray circle.
-        if(move.wasCapture)
+        if(move.isCapture())
             wdl->AddCircleFilled(circlePos, radius, redColor, segmentCount);
         else 
             wdl->AddCircleFilled(circlePos, radius, greyColor, segmentCount);
@@ -682,7 +726,7 @@ void ChessRenderer::drawMainWindow(float const menuBarHeight, Board const& b)
         if( ! mIsPromotionWindowOpen ) [[likely]]
         {
             drawMoveIndicatorCircles(b);
-            drawPieceOnMouse();
+            drawPieceOnMouse(b);
         }
 
         ImVec2 const lastRightClickScreenPos { ImGui::GetIO().MouseClickedPos[ImGuiMouseButton_Right] };
@@ -695,7 +739,7 @@ void ChessRenderer::drawMainWindow(float const menuBarHeight, Board const& b)
         Vec2i lastRightClickMiddleSquarePos { moveToMiddleOfSquare(lastRightClickScreenPos) };
         Vec2i mousePosMiddleSquare { moveToMiddleOfSquare(ImGui::GetMousePos()) };
 
-        bool const isPieceOnMouse { Piece::getPieceOnMouse() };
+        bool const isPieceOnMouse { b.getPieceOnMouse() };
 
         if(ImGui::IsMouseDragging(ImGuiMouseButton_Right) && mIsBoardHovered 
             && wasLastRightClickOnBoard && ! isPieceOnMouse )
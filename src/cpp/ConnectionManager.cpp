@@ -2,6 +2,7 @@
 #include "chessNetworkProtocol.h"
 #include "errorLogger.hpp"
 #include "ChessMove.hpp"
+#include "ProtocolCodec.hpp"
 #include <cassert>
 #include <optional>
 #include <array>
@@ -19,8 +20,9 @@ ConnectionManager::ConnectionManager(NetworkEventSystem::Publisher const& networ
 
 ConnectionManager::~ConnectionManager()
 {
-    //manually ubsub from BoardEvents::MoveCompleted
+    //manually ubsub from BoardEvents::MoveCompleted and BoardEvents::ProtocolError
     mBoardEventSubscriber.unsub<BoardEvents::MoveCompleted>(mMoveCompletedSubID);
+    mBoardEventSubscriber.unsub<BoardEvents::ProtocolError>(mProtocolErrorSubID);
 
     //mGuiEventSubManager will automatically unsub from the rest of the events...
 }
@@ -53,8 +55,24 @@ void ConnectionManager::onPairRequestEvent(GUIEvents::PairRequest const& evnt)
     buildAndSendPairRequest(e.opponentID);
 }
 
+//The board and the opponent's board don't agree anymore so the game can't go on.
+//Unpairing goes through the server just like the user pressing the disconnect button.
+void ConnectionManager::onProtocolErrorEvent(BoardEvents::ProtocolError const& evnt)
+{
+    if(evnt.move.moveType == ChessMove::MoveTypes::INVALID)
+        FileErrorLogger::get().log("protocol error: ", evnt.reason);
+    else
+        FileErrorLogger::get().log("protocol error: ", evnt.reason, " (", toCoordinateNotation(evnt.move), ")");
+
+    if(mIsPairedWithOpponent)
+        sendMessage(ProtocolCodec::UnpairMsg{});
+}
+
 void ConnectionManager::subToEvents()
 {
+    mProtocolErrorSubID = mBoardEventSubscriber.sub<BoardEvents::ProtocolError>(
+        [this](Event const& e){ onProtocolErrorEvent(e.unpack<BoardEvents::ProtocolError>()); });
+
     mGuiEventSubManager.sub<GUIEvents::PairRequest>(GuiSubscriptions::PAIR_REQUEST,
         [this](Event const& e){ onPairRequestEvent(e.unpack<GUIEvents::PairRequest>()); });
 
@@ -65,28 +83,28 @@ void ConnectionManager::subToEvents()
         [this](Event const& e){ buildAndSendPairDecline(); });
 
     mGuiEventSubManager.sub<GUIEvents::DrawOffer>(GuiSubscriptions::DRAW_OFFER,
-        [this](Event const& e){ sendHeaderOnlyMessage(MessageType::DRAW_OFFER_MSGTYPE); });
+        [this](Event const& e){ sendMessage(ProtocolCodec::DrawOfferMsg{}); });
 
     mGuiEventSubManager.sub<GUIEvents::DrawAccept>(GuiSubscriptions::DRAW_ACCEPT,
-        [this](Event const& e){ sendHeaderOnlyMessage(MessageType::DRAW_ACCEPT_MSGTYPE); });
+        [this](Event const& e){ sendMessage(ProtocolCodec::DrawAcceptMsg{}); });
 
     mGuiEventSubManager.sub<GUIEvents::DrawDecline>(GuiSubscriptions::DRAW_DECLINE,
-        [this](Event const& e){ sendHeaderOnlyMessage(MessageType::DRAW_DECLINE_MSGTYPE); });
+        [this](Event const& e){ sendMessage(ProtocolCodec::DrawDeclineMsg{}); });
 
     mGuiEventSubManager.sub<GUIEvents::RematchRequest>(GuiSubscriptions::REMATCH_REQUEST,
-        [this](Event const& e){ sendHeaderOnlyMessage(MessageType::REMATCH_REQUEST_MSGTYPE); });
+        [this](Event const& e){ sendMessage(ProtocolCodec::RematchRequestMsg{}); });
 
     mGuiEventSubManager.sub<GUIEvents::RematchAccept>(GuiSubscriptions::REMATCH_ACCEPT,
-        [this](Event const& e){ sendHeaderOnlyMessage(MessageType::REMATCH_ACCEPT_MSGTYPE); });
+        [this](Event const& e){ sendMessage(ProtocolCodec::RematchAcceptMsg{}); });
 
     mGuiEventSubManager.sub<GUIEvents::RematchDecline>(GuiSubscriptions::REMATCH_DECLINE,
-        [this](Event const& e){ sendHeaderOnlyMessage(MessageType::REMATCH_DECLINE_MSGTYPE); });
+        [this](Event const& e){ sendMessage(ProtocolCodec::RematchDeclineMsg{}); });
 
     mGuiEventSubManager.sub<GUIEvents::Resign>(GuiSubscriptions::RESIGN,
-        [this](Event const& e){ sendHeaderOnlyMessage(MessageType::RESIGN_MSGTYPE); });
+        [this](Event const& e){ sendMessage(ProtocolCodec::ResignMsg{}); });
 
     mGuiEventSubManager.sub<GUIEvents::Unpair>(GuiSubscriptions::UNPAIR,
-        [this](Event const& e){ sendHeaderOnlyMessage(MessageType::UNPAIR_MSGTYPE); });
+        [this](Event const& e){ sendMessage(ProtocolCodec::UnpairMsg{}); });
 }
 
 //Call once per main loop iteration.
@@ -99,79 +117,43 @@ void ConnectionManager::update()
     processNetworkMessages();
 }
 
-//helper to reduce processNetworkMessages() size
-auto ConnectionManager::retrieveNetworkMessages()
-    -> std::optional<NetworkMessages>
+//processNetworkMessages() has already checked the header against chessNetworkProtocol.h,
+//so the message is exactly the right size for Msg and its fields can just be read out.
+template<ProtocolCodec::Message Msg>
+static Msg decodeMessage(std::span<std::byte const> const msg)
 {
-    NetworkMessages ret;
-
-    //Every message has a two byte header as detailed in chessNetworkProtocol.h.
-    auto maybeFirstByte  {mServerConn.peek(0)};
-    auto maybeSecondByte {mServerConn.peek(1)};
-
-    while(maybeFirstByte && maybeSecondByte)
-    {
-        auto const lastByte {mServerConn.peek( static_cast<uint32_t>(*maybeSecondByte) - 1 )};
-
-        //If the server only sent part of the message in the TCP stream.
-        if( ! lastByte )
-            break;
-
-        auto message {mServerConn.read( static_cast<uint32_t>(*maybeSecondByte) )};
-
-        assert(message);//At this point, this should always be true.
-
-        ret.push_back(std::move(*message));//careful! message variable has been moved from
-
-        //mServerConn.read() will erase the last message. Now peek 0 and 1 will
-        //get the next message header if there is one.
-        maybeFirstByte  = mServerConn.peek(0);
-        maybeSecondByte = mServerConn.peek(1);
-    }
-
-    if(ret.size() == 0)
-        return std::nullopt;
-
-    return std::make_optional(std::move(ret));
+    assert(msg.size() == ProtocolCodec::ENCODED_SIZE<Msg> && msg[0] == static_cast<std::byte>(Msg::TYPE));
+    return ProtocolCodec::decodeUnchecked<Msg>(msg.first<ProtocolCodec::ENCODED_SIZE<Msg>>());
 }
 
-void ConnectionManager::handleNewIDMessage(NetworkMessage const& msg)
+void ConnectionManager::handleNewIDMessage(NetworkMessage const msg)
 {
-    uint32_t newID{0};
-    std::memcpy(&newID, msg.data() + 2, sizeof(newID));
-    mUniqueID = ntohl(newID);
+    mUniqueID = decodeMessage<ProtocolCodec::NewIDMsg>(msg).id;
     //pubEvent<NetworkInEvents::NewID>(mUniqueID);
 }
 
-void ConnectionManager::handlePairDeclineMessage(NetworkMessage const& msg)
+void ConnectionManager::handlePairDeclineMessage(NetworkMessage const msg)
 {
     //The ID of the player that declined our PAIR_REQUEST_MSGTYPE message.
-    uint32_t potentialOpponentID{0};
-    std::memcpy(&potentialOpponentID, msg.data() + 2, sizeof(potentialOpponentID));
-
-    mPotentialOpponentID = ntohl(potentialOpponentID);
+    mPotentialOpponentID = decodeMessage<ProtocolCodec::PairDeclineMsg>(msg).id;
 
     pubEvent<NetworkEvents::PairDecline>();
 
     mIsThereAPotentialOpponent = false;
 }
 
-void ConnectionManager::handleIDNotInLobbyMessage(NetworkMessage const& msg)
+void ConnectionManager::handleIDNotInLobbyMessage(NetworkMessage const msg)
 {
     mIsThereAPotentialOpponent = false;
 
-    uint32_t invalidID{0};
-    std::memcpy(&invalidID, msg.data() + 2, sizeof(invalidID));
-    invalidID = ntohl(invalidID);
-
-    pubEvent<NetworkEvents::IDNotInLobby>(invalidID);
+    pubEvent<NetworkEvents::IDNotInLobby>(decodeMessage<ProtocolCodec::IDNotInLobbyMsg>(msg).id);
 }
 
 //Helper to reduce processNetworkMessages() size.
-void ConnectionManager::processNetworkMessage(NetworkMessage const& msg)
+void ConnectionManager::processNetworkMessage(NetworkMessage const msg)
 {
     //The second byte of the two byte header is the size of the total message.
-    assert(static_cast<size_t>(msg.at(1)) == msg.size());
+    assert(std::to_integer<size_t>(msg[1]) == msg.size());
 
     switch(static_cast<MessageType>(msg[0]))
     {
@@ -195,15 +177,38 @@ void ConnectionManager::processNetworkMessage(NetworkMessage const& msg)
     }
 }
 
-//Processes incoming network messages.
+//Processes incoming network messages. Each one is framed and handled straight out of
+//the receive buffer, so nothing is copied or allocated per message.
 void ConnectionManager::processNetworkMessages()
 {
-    auto maybeMessages {retrieveNetworkMessages()};
-    if( ! maybeMessages.has_value() )
-        return;
+    //Every message has a two byte header as detailed in chessNetworkProtocol.h.
+    auto msgType {mServerConn.peek(0)};
+    auto msgSize {mServerConn.peek(1)};
+
+    while(msgType && msgSize)
+    {
+        //A header that doesn't match chessNetworkProtocol.h means there is no telling
+        //where the next message starts, so the rest of the stream is useless.
+        if( ! ProtocolCodec::isValidHeader(*msgType, *msgSize) )
+        {
+            FileErrorLogger::get().log("invalid message header sent from the server (type ",
+                std::to_integer<int>(*msgType), " size ", std::to_integer<int>(*msgSize), ")");
+            mServerConn.disconnect();
+            return;
+        }
+
+        //If the server only sent part of the message in the TCP stream.
+        auto const msg {mServerConn.read(std::to_integer<size_t>(*msgSize))};
+        if( ! msg )
+            return;
 
-    for(auto const& msg : *maybeMessages)
-        processNetworkMessage(msg);
+        processNetworkMessage(*msg);
+
+        //mServerConn.read() has consumed the last message. Now peek 0 and 1 will
+        //get the next message header if there is one.
+        msgType = mServerConn.peek(0);
+        msgSize = mServerConn.peek(1);
+    }
 }
 
 void ConnectionManager::handleOpponentClosedConnectionMessage()
@@ -218,9 +223,17 @@ void ConnectionManager::handleRematchDeclineMessage()
     pubEvent<NetworkEvents::RematchDecline>();
 }
 
-void ConnectionManager::handlePairingCompleteMessage(NetworkMessage const& msg)
+void ConnectionManager::handlePairingCompleteMessage(NetworkMessage const msg)
 {
-    auto const side { static_cast<Side>(msg[2]) };
+    auto const side {ProtocolCodec::toSide(decodeMessage<ProtocolCodec::PairingCompleteMsg>(msg))};
+    if( ! side )
+    {
+        //There's no game to play without knowing which side we are, so undo the pairing.
+        FileErrorLogger::get().log("pairing complete message sent from the server with an invalid side");
+        mIsThereAPotentialOpponent = false;
+        sendMessage(ProtocolCodec::UnpairMsg{});
+        return;
+    }
 
     mIsPairedWithOpponent = true;
     mIsThereAPotentialOpponent = false;
@@ -233,51 +246,28 @@ void ConnectionManager::handlePairingCompleteMessage(NetworkMessage const& msg)
         if( ! evnt.move.wasOpponentsMove) { buildAndSendMoveMsgType(evnt.move); }
     });
 
-    pubEvent<NetworkEvents::PairingComplete>(mOpponentID, side);
+    pubEvent<NetworkEvents::PairingComplete>(mOpponentID, *side);
 }
 
-void ConnectionManager::handlePairRequestMessage(NetworkMessage const& msg)
+void ConnectionManager::handlePairRequestMessage(NetworkMessage const msg)
 {
-    //Step over the two byte header then extract the ID.
-    uint32_t potentialOpponentID{0};
-    std::memcpy(&potentialOpponentID, msg.data() + 2, sizeof(potentialOpponentID));
-
-    mPotentialOpponentID = ntohl(potentialOpponentID);
+    mPotentialOpponentID = decodeMessage<ProtocolCodec::PairRequestMsg>(msg).id;
     mIsThereAPotentialOpponent = true;
 
     pubEvent<NetworkEvents::PairRequest>(mPotentialOpponentID);
 }
 
-void ConnectionManager::handleMoveMessage(NetworkMessage const& netMsg)
+void ConnectionManager::handleMoveMessage(NetworkMessage const netMsg)
 {
-    //The size of netMsg is asserted to be correct in processNetworkMessage()
-
-    // |0|1|2|3|4|5|6|7|8|9|
-    //byte 0 will be the MOVE_MSGTYPE  <--- header bytes
-    //byte 1 will be the MOVE_MSGSIZE  <---
-    //
-    //byte 2 will be the file (0-7) the piece if moving from   <--- source square
-    //byte 3 will be the rank (0-7) the piece if moving from   <---
-    // 
-    //byte 4 will be the file (0-7) the piece if moving to   <--- destination square
-    //byte 5 will be the rank (0-7) the piece if moving to   <---
-    // 
-    //byte 6 will be the PromoType (enum defined in (client source)moveInfo.h) of the promotion if there is one
-    //byte 7 will be the MoveInfo (enum defined in (client source)moveInfo.h)
-    //byte 8 will be the ChessMove::rightsToRevoke as a uint32_t
-    //byte 9 will be the ChessMove::wasCapture bool
-
-    ChessMove const move
+    //The layout of the message is in chessNetworkProtocol.h and ProtocolCodec.cpp.
+    auto const move {ProtocolCodec::toPackedMove(decodeMessage<ProtocolCodec::MoveMsg>(netMsg))};
+    if( ! move )
     {
-        {static_cast<int>(netMsg[2]), static_cast<int>(netMsg[3])},//source square
-        {static_cast<int>(netMsg[4]), static_cast<int>(netMsg[5])},//dest square
-        static_cast<bool>(netMsg[9]),
-        static_cast<ChessMove::MoveTypes>(netMsg[7]),
-        static_cast<unsigned char>(netMsg[8]),
-        static_cast<ChessMove::PromoTypes>(netMsg[6])
-    };
-
-    pubEvent<NetworkEvents::OpponentMadeMove>(move);
+        pubEvent<NetworkEvents::OpponentSentMalformedMove>();
+        return;
+    }
+
+    pubEvent<NetworkEvents::OpponentMadeMove>(move->toChessMove());
 }
 
 bool ConnectionManager::isOpponentIDStringValid(std::string_view opponentID)
@@ -320,36 +310,7 @@ void ConnectionManager::pubEvent(EventArgs&&... eventArgs)
 
 void ConnectionManager::buildAndSendMoveMsgType(ChessMove const& move)
 {
-    //Pack all of the move information into a buffer to be sent over the network.
-    std::array<std::byte, static_cast<size_t>(MessageSize::MOVE_MSGSIZE)> msgBuff {};
-
-    // |0|1|2|3|4|5|6|7|8|9|
-    //byte 0 will be the MOVE_MSGTYPE  <--- header bytes
-    //byte 1 will be the MOVE_MSGSIZE  <---
-    //
-    //byte 2 will be the file (0-7) the piece if moving from   <--- source square
-    //byte 3 will be the rank (0-7) the piece if moving from   <---
-    // 
-    //byte 4 will be the file (0-7) the piece if moving to   <--- destination square
-    //byte 5 will be the rank (0-7) the piece if moving to   <---
-    // 
-    //byte 6 will be the PromoType (enum defined in (client source)moveInfo.h) of the promotion if there is one
-    //byte 7 will be the MoveInfo (enum defined in (client source)moveInfo.h)
-    //byte 8 will be the ChessMove::rightsToRevoke as an unsigned char
-    //byte 9 will be the ChessMove::wasCapture bool
-
-    msgBuff[0] = static_cast<std::byte>(MessageType::MOVE_MSGTYPE);
-    msgBuff[1] = static_cast<std::byte>(MessageSize::MOVE_MSGSIZE);
-    msgBuff[2] = static_cast<std::byte>(move.src.x);
-    msgBuff[3] = static_cast<std::byte>(move.src.y);
-    msgBuff[4] = static_cast<std::byte>(move.dest.x);
-    msgBuff[5] = static_cast<std::byte>(move.dest.y);
-    msgBuff[6] = static_cast<std::byte>(move.promoType);
-    msgBuff[7] = static_cast<std::byte>(move.moveType);
-    msgBuff[8] = static_cast<std::byte>(move.rightsToRevoke.getRights());
-    msgBuff[9] = static_cast<std::byte>(move.wasCapture);
-
-    mServerConn.write(msgBuff);
+    sendMessage(ProtocolCodec::toMoveMsg(PackedMove{move}));
 }
 
 void ConnectionManager::buildAndSendPairRequest(uint32_t potentialOpponent)
@@ -357,44 +318,27 @@ void ConnectionManager::buildAndSendPairRequest(uint32_t potentialOpponent)
     mPotentialOpponentID = potentialOpponent;
     mIsThereAPotentialOpponent = true;
 
-    potentialOpponent = htonl(potentialOpponent);//Swap to network byte order if necessary.
-
-    std::array<std::byte, static_cast<size_t>(MessageSize::PAIR_REQUEST_MSGSIZE)> msgBuff {};
-    msgBuff[0] = static_cast<std::byte>(MessageType::PAIR_REQUEST_MSGTYPE);
-    msgBuff[1] = static_cast<std::byte>(MessageSize::PAIR_REQUEST_MSGSIZE);
-    std::memcpy(msgBuff.data() + 2, &potentialOpponent, sizeof(potentialOpponent));
-    
-    mServerConn.write(msgBuff);
+    sendMessage(ProtocolCodec::PairRequestMsg{potentialOpponent});
 }
 
 void ConnectionManager::buildAndSendPairAccept()
 {
     assert(mIsThereAPotentialOpponent);
 
-    uint32_t opponentID = htonl(mPotentialOpponentID);
-    std::array<std::byte, static_cast<size_t>(MessageSize::PAIR_ACCEPT_MSGSIZE)> msgBuff {};
-    msgBuff[0] = static_cast<std::byte>(MessageType::PAIR_ACCEPT_MSGTYPE);
-    msgBuff[1] = static_cast<std::byte>(MessageSize::PAIR_ACCEPT_MSGSIZE);
-    std::memcpy(msgBuff.data() + 2, &opponentID, sizeof(opponentID));
-    mServerConn.write(msgBuff);
+    sendMessage(ProtocolCodec::PairAcceptMsg{mPotentialOpponentID});
 }
 
 void ConnectionManager::buildAndSendPairDecline()
 {
     assert(mIsThereAPotentialOpponent);
 
-    uint32_t potentialOpponentID = htonl(mPotentialOpponentID);
-    std::array<std::byte, static_cast<size_t>(MessageSize::PAIR_DECLINE_MSGSIZE)> msgBuff {};
-    msgBuff[0] = static_cast<std::byte>(MessageType::PAIR_DECLINE_MSGTYPE);
-    msgBuff[1] = static_cast<std::byte>(MessageSize::PAIR_DECLINE_MSGSIZE);
-    std::memcpy(msgBuff.data() + 2, &potentialOpponentID, sizeof(potentialOpponentID));
-    mServerConn.write(msgBuff);
+    sendMessage(ProtocolCodec::PairDeclineMsg{mPotentialOpponentID});
 }
 
-//A lot of messages have no "payload", but just the two byte header.
-void ConnectionManager::sendHeaderOnlyMessage(MessageType msgType)
+template<ProtocolCodec::Message Msg>
+void ConnectionManager::sendMessage(Msg const& msg)
 {
-    std::array<std::byte, 2> msgBuff{ static_cast<std::byte>(msgType), std::byte{2} };
+    auto const msgBuff {ProtocolCodec::encode(msg)};
     mServerConn.write(msgBuff);
 }
 
@@ -0,0 +1,99 @@
+#include "Engine.hpp"
+#include "Board.hpp"
+#include <algorithm>
+#include <iterator>
+
+Engine::Engine(Board const& board, EngineEventSystem::Publisher const& engineEventPublisher,
+    GUIEventSystem::Subscriber& guiEventSubscriber, NetworkEventSystem::Subscriber& networkEventSubscriber)
+
+    : mBoard{board},
+      mEngineEventPublisher{engineEventPublisher},
+      mGuiSubManager{guiEventSubscriber},
+      mNetworkSubManager{networkEventSubscriber}
+{
+    subToEvents();
+
+    mGameMoves.reserve(256);
+}
+
+//Helper function to reduce constructor size.
+void Engine::subToEvents()
+{
+    mGuiSubManager.sub<GUIEvents::PlayAgainstEngine>(SubscriptionTypes::PLAY_AGAINST_ENGINE,
+    [this](Event const& e)
+    {
+        stopSearch();
+        mEngineSide = e.unpack<GUIEvents::PlayAgainstEngine>().engineSide;
+    });
+
+    //the engine stops playing when paired with someone online
+    mNetworkSubManager.sub<NetworkEvents::PairingComplete>(SubscriptionTypes::PAIRING_COMPLETE,
+    [this](Event const&)
+    {
+        stopSearch();
+        mEngineSide = Side::INVALID;
+    });
+}
+
+void Engine::update()
+{
+    if(isSearching())
+    {
+        if( ! mIsResultReady )
+        {
+            //No point waiting for a move that will be thrown away.
+            if( ! isPlaying() || ! isBoardStillAtSearchedPosition() )
+                mSearchThread.request_stop();
+
+            return;
+        }
+
+        mSearchThread.join();
+        mIsResultReady = false;
+
+        auto const& result {mResult.mainThreadResult};
+        if(isPlaying() && isBoardStillAtSearchedPosition() && result.bestMove)
+        {
+            EngineEvents::BestMoveFound evnt {result.bestMove.toChessMove(), result.score, result.depth, mResult.totalNodes, mResult.getNodesPerSecond()};
+            mEngineEventPublisher.pub(evnt);
+        }
+
+        return;
+    }
+
+    if(isPlaying() && mBoard.getWhosTurnItIs() == mEngineSide && ! mBoard.isGameOver())
+        startSearch();
+}
+
+void Engine::startSearch()
+{
+    mGameMoves.clear();
+    std::ranges::copy(mBoard.getMoveHistory(), std::back_inserter(mGameMoves));
+    mSearch.setPosition(mBoard.getStartingFEN(), mGameMoves);
+
+    mSearchedHash = mBoard.getHash();
+    mSearchedMoveCount = mGameMoves.size();
+    mIsResultReady = false;
+
+    mSearchThread = std::jthread{[this](std::stop_token stopToken)
+    {
+        mResult = mSearch.run(mSearchLimits, std::move(stopToken));
+        mIsResultReady = true;
+    }};
+}
+
+void Engine::stopSearch()
+{
+    if( ! isSearching() )
+        return;
+
+    mSearchThread.request_stop();
+    mSearchThread.join();
+    mIsResultReady = false;
+}
+
+bool Engine::isBoardStillAtSearchedPosition() const
+{
+    return mBoard.getHash() == mSearchedHash &&
+        static_cast<size_t>(std::ranges::distance(mBoard.getMoveHistory())) == mSearchedMoveCount;
+}
@@ -0,0 +1,70 @@
+#include "EngineSettings.hpp"
+#include "SettingsFileManager.hpp"
+#include "errorLogger.hpp"
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <optional>
+#include <string>
+#include <thread>
+
+static auto const engineSettingsFname {"engineSettings.txt"};
+
+static std::optional<int> parsePositiveInt(std::string const& str)
+{
+    int value {0};
+    auto const [ptr, ec] {std::from_chars(str.data(), str.data() + str.size(), value)};
+    if(ec != std::errc{} || ptr != str.data() + str.size() || value < 1)
+        return std::nullopt;
+    return value;
+}
+
+static void generateNewEngineSettingsFile(SettingsManager const& settingsManager, EngineSettings const& defaults)
+{
+    std::array<std::string, 3> const comments
+    {
+        "threads is how many threads the computer opponent searches with (every core by default).",
+        "hashMB is the size of its transposition table in megabytes.",
+        "If you accidentally mess this file up, just delete it and it will be generated again."
+    };
+
+    std::array const kvPairs
+    {
+        SettingsManager::KVPair{"threads", std::to_string(defaults.numThreads)},
+        SettingsManager::KVPair{"hashMB", std::to_string(defaults.hashSizeMB)}
+    };
+
+    if(auto maybeError {settingsManager.generateNewFile(comments, kvPairs)})
+        FileErrorLogger::get().log(maybeError->msg);
+}
+
+EngineSettings EngineSettings::load()
+{
+    EngineSettings settings {};
+    settings.numThreads = static_cast<int>(std::max(std::thread::hardware_concurrency(), 1u));
+
+    SettingsManager settingsManager {engineSettingsFname};
+
+    auto const maybeThreads {settingsManager.getValue("threads")};
+    if( ! maybeThreads && maybeThreads.error().code == SettingsManager::Error::Code::FILE_NOT_FOUND )
+    {
+        generateNewEngineSettingsFile(settingsManager, settings);
+        return settings;
+    }
+
+    auto const maybeHashMB {settingsManager.getValue("hashMB")};
+
+    for(auto const& maybeValue : {maybeThreads, maybeHashMB})
+    {
+        if( ! maybeValue )
+            FileErrorLogger::get().log(maybeValue.error().msg);
+    }
+
+    if(auto const threads {maybeThreads ? parsePositiveInt(*maybeThreads) : std::nullopt})
+        settings.numThreads = *threads;
+
+    if(auto const hashMB {maybeHashMB ? parsePositiveInt(*maybeHashMB) : std::nullopt})
+        settings.hashSizeMB = static_cast<size_t>(*hashMB);
+
+    return settings;
+}
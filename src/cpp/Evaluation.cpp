@@ -0,0 +1,136 @@
+#include "Evaluation.hpp"
+
+using PieceSquareTable = std::array<int, 64>;
+
+//The tables are laid out the way the board looks from white's side (a8 is the first entry and h1 is the last),
+//so a white piece on square sq uses entry sq ^ 56 and a black piece uses entry sq (the table mirrored vertically).
+static constexpr PieceSquareTable s_pawnTable
+{
+     0,  0,  0,  0,  0,  0,  0,  0,
+    50, 50, 50, 50, 50, 50, 50, 50,
+    10, 10, 20, 30, 30, 20, 10, 10,
+     5,  5, 10, 25, 25, 10,  5,  5,
+     0,  0,  0, 20, 20,  0,  0,  0,
+     5, -5,-10,  0,  0,-10, -5,  5,
+     5, 10, 10,-20,-20, 10, 10,  5,
+     0,  0,  0,  0,  0,  0,  0,  0
+};
+
+static constexpr PieceSquareTable s_knightTable
+{
+    -50,-40,-30,-30,-30,-30,-40,-50,
+    -40,-20,  0,  0,  0,  0,-20,-40,
+    -30,  0, 10, 15, 15, 10,  0,-30,
+    -30,  5, 15, 20, 20, 15,  5,-30,
+    -30,  0, 15, 20, 20, 15,  0,-30,
+    -30,  5, 10, 15, 15, 10,  5,-30,
+    -40,-20,  0,  5,  5,  0,-20,-40,
+    -50,-40,-30,-30,-30,-30,-40,-50
+};
+
+static constexpr PieceSquareTable s_bishopTable
+{
+    -20,-10,-10,-10,-10,-10,-10,-20,
+    -10,  0,  0,  0,  0,  0,  0,-10,
+    -10,  0,  5, 10, 10,  5,  0,-10,
+    -10,  5,  5, 10, 10,  5,  5,-10,
+    -10,  0, 10, 10, 10, 10,  0,-10,
+    -10, 10, 10, 10, 10, 10, 10,-10,
+    -10,  5,  0,  0,  0,  0,  5,-10,
+    -20,-10,-10,-10,-10,-10,-10,-20
+};
+
+static constexpr PieceSquareTable s_rookTable
+{
+     0,  0,  0,  0,  0,  0,  0,  0,
+     5, 10, 10, 10, 10, 10, 10,  5,
+    -5,  0,  0,  0,  0,  0,  0, -5,
+    -5,  0,  0,  0,  0,  0,  0, -5,
+    -5,  0,  0,  0,  0,  0,  0, -5,
+    -5,  0,  0,  0,  0,  0,  0, -5,
+    -5,  0,  0,  0,  0,  0,  0, -5,
+     0,  0,  0,  5,  5,  0,  0,  0
+};
+
+static constexpr PieceSquareTable s_queenTable
+{
+    -20,-10,-10, -5, -5,-10,-10,-20,
+    -10,  0,  0,  0,  0,  0,  0,-10,
+    -10,  0,  5,  5,  5,  5,  0,-10,
+     -5,  0,  5,  5,  5,  5,  0, -5,
+      0,  0,  5,  5,  5,  5,  0, -5,
+    -10,  5,  5,  5,  5,  5,  0,-10,
+    -10,  0,  5,  0,  0,  0,  0,-10,
+    -20,-10,-10, -5, -5,-10,-10,-20
+};
+
+//The king should hide behind its pawns while there are pieces around to attack it...
+static constexpr PieceSquareTable s_kingMiddlegameTable
+{
+    -30,-40,-40,-50,-50,-40,-40,-30,
+    -30,-40,-40,-50,-50,-40,-40,-30,
+    -30,-40,-40,-50,-50,-40,-40,-30,
+    -30,-40,-40,-50,-50,-40,-40,-30,
+    -20,-30,-30,-40,-40,-30,-30,-20,
+    -10,-20,-20,-20,-20,-20,-20,-10,
+     20, 20,  0,  0,  0,  0, 20, 20,
+     20, 30, 10,  0,  0, 10, 30, 20
+};
+
+//...and come out to the center once they are gone.
+static constexpr PieceSquareTable s_kingEndgameTable
+{
+    -50,-40,-30,-20,-20,-30,-40,-50,
+    -30,-20,-10,  0,  0,-10,-20,-30,
+    -30,-10, 20, 30, 30, 20,-10,-30,
+    -30,-10, 30, 40, 40, 30,-10,-30,
+    -30,-10, 30, 40, 40, 30,-10,-30,
+    -30,-10, 20, 30, 30, 20,-10,-30,
+    -30,-30,  0,  0,  0,  0,-30,-30,
+    -50,-30,-30,-30,-30,-30,-30,-50
+};
+
+//Once the material on the board (not counting pawns and kings) drops to this, the kings use the endgame table.
+static constexpr int ENDGAME_MATERIAL {2 * (500 + 330)};
+
+static int evaluatePieces(Bitboard pieces, PieceSquareTable const& table, int const value, bool const isWhite)
+{
+    int score {0};
+    while(pieces)
+    {
+        Square const sq {popLsb(pieces)};
+        score += value + table[isWhite ? sq ^ 56 : sq];
+    }
+    return score;
+}
+
+int Evaluation::evaluate(Position const& position, Side const sideToMove)
+{
+    using enum PieceTypes;
+
+    int nonPawnMaterial {0};
+    for(auto const type : {ROOK, KNIGHT, BISHOP, QUEEN})
+        nonPawnMaterial += popCount(position.getPieces(type)) * getPieceValue(type);
+
+    auto const& kingTable {nonPawnMaterial <= ENDGAME_MATERIAL ? s_kingEndgameTable : s_kingMiddlegameTable};
+
+    int whiteScore {0};
+    for(auto const side : {Side::WHITE, Side::BLACK})
+    {
+        bool const isWhite {side == Side::WHITE};
+
+        int const score
+        {
+            evaluatePieces(position.getPieces(side, PAWN),   s_pawnTable,   getPieceValue(PAWN),   isWhite) +
+            evaluatePieces(position.getPieces(side, KNIGHT), s_knightTable, getPieceValue(KNIGHT), isWhite) +
+            evaluatePieces(position.getPieces(side, BISHOP), s_bishopTable, getPieceValue(BISHOP), isWhite) +
+            evaluatePieces(position.getPieces(side, ROOK),   s_rookTable,   getPieceValue(ROOK),   isWhite) +
+            evaluatePieces(position.getPieces(side, QUEEN),  s_queenTable,  getPieceValue(QUEEN),  isWhite) +
+            evaluatePieces(position.getPieces(side, KING),   kingTable,     0,                     isWhite)
+        };
+
+        whiteScore += isWhite ? score : -score;
+    }
+
+    return sideToMove == Side::WHITE ? whiteScore : -whiteScore;
+}
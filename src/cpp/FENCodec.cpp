@@ -0,0 +1,281 @@
+#include "FENCodec.hpp"
+#include "MoveGen.hpp"
+#include <array>
+#include <charconv>
+#include <optional>
+
+static constexpr std::string_view PIECE_CHARS {" prnbqk"}; //indexed by PieceTypes
+
+static std::optional<PieceCode> toPieceCode(char const c)
+{
+    bool const isWhite {c >= 'A' && c <= 'Z'};
+    auto const index {PIECE_CHARS.find(isWhite ? static_cast<char>(c - 'A' + 'a') : c)};
+    if(index == std::string_view::npos || index == 0)
+        return std::nullopt;
+
+    return PieceCode{isWhite ? Side::WHITE : Side::BLACK, static_cast<PieceTypes>(index)};
+}
+
+static char toChar(PieceCode const code)
+{
+    char const c {PIECE_CHARS[static_cast<size_t>(code.getType())]};
+    return code.getSide() == Side::WHITE ? static_cast<char>(c - 'a' + 'A') : c;
+}
+
+//The castle rights in FEN order, the king and rook that have to be on their starting squares for each of them.
+struct CastleField
+{
+    char c;
+    CastleRights::Rights rights;
+    Side side;
+    Square kingSq;
+    Square rookSq;
+};
+
+static constexpr std::array<CastleField, 4> s_castleFields
+{{
+    {'K', CastleRights::Rights::WSHORT, Side::WHITE, 4, 7},
+    {'Q', CastleRights::Rights::WLONG,  Side::WHITE, 4, 0},
+    {'k', CastleRights::Rights::BSHORT, Side::BLACK, 60, 63},
+    {'q', CastleRights::Rights::BLONG,  Side::BLACK, 60, 56},
+}};
+
+//Moves i past the next space separated field of fen and returns it (empty if there are no fields left).
+//fieldStart is set to where the field starts, for the error positions.
+static std::string_view nextField(std::string_view const fen, size_t& i, size_t& fieldStart)
+{
+    while(i < fen.size() && fen[i] == ' ')
+        ++i;
+
+    fieldStart = i;
+    while(i < fen.size() && fen[i] != ' ')
+        ++i;
+
+    return fen.substr(fieldStart, i - fieldStart);
+}
+
+static std::optional<int> parseInt(std::string_view const str)
+{
+    int value {0};
+    auto const [ptr, ec] {std::from_chars(str.data(), str.data() + str.size(), value)};
+    if(ec != std::errc{} || ptr != str.data() + str.size())
+        return std::nullopt;
+    return value;
+}
+
+std::expected<FENPosition, FENError> FENCodec::parse(std::string_view const fen)
+{
+    auto const fail = [](size_t const position, std::string_view const message)
+    {
+        return std::unexpected{FENError{position, message}};
+    };
+
+    FENPosition out;
+    size_t i {0};
+    size_t fieldStart {0};
+
+    //piece placement, rank 8 first
+    auto const placement {nextField(fen, i, fieldStart)};
+    if(placement.empty())
+        return fail(fieldStart, "missing piece placement");
+
+    int rank {7};
+    int file {0};
+    for(size_t j = 0; j < placement.size(); ++j)
+    {
+        char const c {placement[j]};
+        size_t const position {fieldStart + j};
+
+        if(c == '/')
+        {
+            if(file != 8)
+                return fail(position, "rank doesn't have 8 squares");
+            if(rank == 0)
+                return fail(position, "more than 8 ranks");
+
+            --rank;
+            file = 0;
+        }
+        else if(c >= '1' && c <= '8')
+        {
+            file += c - '0';
+            if(file > 8)
+                return fail(position, "rank has more than 8 squares");
+        }
+        else if(c == '0' || c == '9')
+            return fail(position, "empty square count isn't 1 to 8");
+        else
+        {
+            auto const code {toPieceCode(c)};
+            if( ! code )
+                return fail(position, "unknown piece");
+            if(file > 7)
+                return fail(position, "rank has more than 8 squares");
+            if(code->getType() == PieceTypes::PAWN && (rank == 0 || rank == 7))
+                return fail(position, "pawn on the first or last rank");
+
+            out.position.putPiece(rank * 8 + file, *code);
+            ++file;
+        }
+    }
+
+    if(rank != 0 || file != 8)
+        return fail(fieldStart + placement.size(), "piece placement doesn't have 8 ranks of 8 squares");
+
+    if(popCount(out.position.getPieces(Side::WHITE, PieceTypes::KING)) != 1)
+        return fail(fieldStart, "there has to be exactly one white king");
+    if(popCount(out.position.getPieces(Side::BLACK, PieceTypes::KING)) != 1)
+        return fail(fieldStart, "there has to be exactly one black king");
+
+    //side to move
+    auto const side {nextField(fen, i, fieldStart)};
+    if(side == "w")      out.sideToMove = Side::WHITE;
+    else if(side == "b") out.sideToMove = Side::BLACK;
+    else return fail(fieldStart, side.empty() ? "missing side to move" : "side to move isn't w or b");
+
+    //castle rights
+    auto const castling {nextField(fen, i, fieldStart)};
+    if(castling.empty())
+        return fail(fieldStart, "missing castle rights");
+
+    if(castling != "-")
+    {
+        //the rights have to be in KQkq order, so each one can only come after the one before it
+        size_t nextCastleField {0};
+        for(size_t j = 0; j < castling.size(); ++j)
+        {
+            while(nextCastleField < s_castleFields.size() && s_castleFields[nextCastleField].c != castling[j])
+                ++nextCastleField;
+
+            if(nextCastleField == s_castleFields.size())
+                return fail(fieldStart + j, "castle rights aren't - or some of KQkq in that order");
+
+            auto const& field {s_castleFields[nextCastleField++]};
+            if(out.position.pieceAt(field.kingSq) != PieceCode{field.side, PieceTypes::KING} ||
+               out.position.pieceAt(field.rookSq) != PieceCode{field.side, PieceTypes::ROOK})
+            {
+                return fail(fieldStart + j, "castle right without the king and rook on their starting squares");
+            }
+
+            out.castleRights.addRights(field.rights);
+        }
+    }
+
+    //en passant square. It is behind the pawn that just moved two squares, which belongs to the side not to move.
+    auto const enPassant {nextField(fen, i, fieldStart)};
+    if(enPassant.empty())
+        return fail(fieldStart, "missing en passant square");
+
+    if(enPassant != "-")
+    {
+        bool const isWhiteToMove {out.sideToMove == Side::WHITE};
+        if(enPassant.size() != 2 || enPassant[0] < 'a' || enPassant[0] > 'h' || enPassant[1] != (isWhiteToMove ? '6' : '3'))
+            return fail(fieldStart, isWhiteToMove ? "en passant square isn't - or on the 6th rank" : "en passant square isn't - or on the 3rd rank");
+
+        Square const epSq {(isWhiteToMove ? 5 : 2) * 8 + (enPassant[0] - 'a')};
+        int const forward {isWhiteToMove ? 8 : -8}; //from the pawn that can be taken towards the square it came from
+        Side const moved {isWhiteToMove ? Side::BLACK : Side::WHITE};
+
+        if(out.position.pieceAt(epSq - forward) != PieceCode{moved, PieceTypes::PAWN} ||
+           out.position.pieceAt(epSq) || out.position.pieceAt(epSq + forward))
+        {
+            return fail(fieldStart, "en passant square isn't behind a pawn that just moved two squares");
+        }
+
+        out.enPassantSquare = epSq;
+    }
+
+    //the clocks, which are optional
+    auto const halfmove {nextField(fen, i, fieldStart)};
+    if( ! halfmove.empty() )
+    {
+        auto const value {parseInt(halfmove)};
+        if( ! value || *value < 0 )
+            return fail(fieldStart, "halfmove clock isn't a number of at least 0");
+        out.halfmoveClock = *value;
+
+        auto const fullmove {nextField(fen, i, fieldStart)};
+        if(fullmove.empty())
+            return fail(fieldStart, "missing fullmove number");
+
+        auto const fullmoveValue {parseInt(fullmove)};
+        if( ! fullmoveValue || *fullmoveValue < 1 )
+            return fail(fieldStart, "fullmove number isn't a number of at least 1");
+        out.fullmoveNumber = *fullmoveValue;
+    }
+
+    if( ! nextField(fen, i, fieldStart).empty() )
+        return fail(fieldStart, "unexpected text after the last field");
+
+    //the side that just moved can't have left its king in check
+    Side const notToMove {out.sideToMove == Side::WHITE ? Side::BLACK : Side::WHITE};
+    if(MoveGen::getAttackersTo(out.position, out.position.getKingSquare(notToMove), out.sideToMove, out.position.getOccupied()))
+        return fail(0, "the side not to move is in check");
+
+    return out;
+}
+
+std::string_view FENCodec::write(FENPosition const& fen, std::span<char, MAX_LENGTH> const out)
+{
+    size_t n {0};
+    auto const put = [&](char const c){ out[n++] = c; };
+
+    auto const putInt = [&](int const value)
+    {
+        auto const [ptr, ec] {std::to_chars(out.data() + n, out.data() + out.size(), value)};
+        n = static_cast<size_t>(ptr - out.data());
+    };
+
+    for(int rank = 7; rank >= 0; --rank)
+    {
+        int emptyCount {0};
+        for(int file = 0; file < 8; ++file)
+        {
+            PieceCode const code {fen.position.pieceAt(rank * 8 + file)};
+            if( ! code )
+            {
+                ++emptyCount;
+                continue;
+            }
+
+            if(emptyCount)
+                put(static_cast<char>('0' + emptyCount));
+            emptyCount = 0;
+            put(toChar(code));
+        }
+
+        if(emptyCount)
+            put(static_cast<char>('0' + emptyCount));
+        if(rank)
+            put('/');
+    }
+
+    put(' ');
+    put(fen.sideToMove == Side::WHITE ? 'w' : 'b');
+
+    put(' ');
+    size_t const castleStart {n};
+    for(auto const& field : s_castleFields)
+    {
+        if(fen.castleRights.hasRights(field.rights))
+            put(field.c);
+    }
+    if(n == castleStart)
+        put('-');
+
+    put(' ');
+    if(fen.enPassantSquare == INVALID_SQUARE)
+        put('-');
+    else
+    {
+        put(static_cast<char>('a' + fen.enPassantSquare % 8));
+        put(static_cast<char>('1' + fen.enPassantSquare / 8));
+    }
+
+    put(' ');
+    putInt(fen.halfmoveClock);
+    put(' ');
+    putInt(fen.fullmoveNumber);
+
+    return {out.data(), n};
+}
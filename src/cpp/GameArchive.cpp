@@ -0,0 +1,192 @@
+#include "GameArchive.hpp"
+#include <cstring>
+#include <system_error>
+
+GameArchive::Result GameArchive::toResult(std::string_view const pgnResult)
+{
+    if(pgnResult == "1-0")     return Result::WHITE_WINS;
+    if(pgnResult == "0-1")     return Result::BLACK_WINS;
+    if(pgnResult == "1/2-1/2") return Result::DRAW;
+    return Result::UNKNOWN;
+}
+
+std::string_view GameArchive::toPGNResult(Result const result)
+{
+    switch(result)
+    {
+    case Result::WHITE_WINS: return "1-0";
+    case Result::BLACK_WINS: return "0-1";
+    case Result::DRAW:       return "1/2-1/2";
+    default:                 return "*";
+    }
+}
+
+std::filesystem::path GameArchive::getIndexPath(std::filesystem::path const& archivePath)
+{
+    auto indexPath {archivePath};
+    return indexPath += ".idx";
+}
+
+static void writeBytes(std::ofstream& out, void const* const data, size_t const size)
+{
+    out.write(static_cast<char const*>(data), static_cast<std::streamsize>(size));
+}
+
+//Opens path for appending, writing the file header if the file is new or empty and checking it if it isn't.
+//size is set to the size of the file. False if the file can't be opened or its header is wrong.
+//If entrySize isn't 0 the file is cut back to a whole number of entries after the header first.
+static bool openForAppend(std::ofstream& out, std::filesystem::path const& path,
+    std::array<char, 8> const& magic, uint64_t& size, uint64_t const entrySize = 0)
+{
+    std::error_code ec;
+    size = std::filesystem::exists(path, ec) ? std::filesystem::file_size(path, ec) : 0;
+    if(ec)
+        return false;
+
+    //an entry that was cut short (by a crash) would throw every entry after it out of line
+    if(entrySize && size > sizeof(GameArchive::FileHeader) && (size - sizeof(GameArchive::FileHeader)) % entrySize)
+    {
+        size -= (size - sizeof(GameArchive::FileHeader)) % entrySize;
+        std::filesystem::resize_file(path, size, ec);
+        if(ec)
+            return false;
+    }
+
+    if(size != 0)
+    {
+        GameArchive::FileHeader header {};
+        std::ifstream existing {path, std::ios::binary};
+        existing.read(reinterpret_cast<char*>(&header), sizeof(header));
+        if( ! existing || header.magic != magic || header.version != GameArchive::VERSION )
+            return false;
+    }
+
+    out.open(path, std::ios::binary | std::ios::app);
+    if( ! out )
+        return false;
+
+    if(size == 0)
+    {
+        GameArchive::FileHeader const header {magic, GameArchive::VERSION, 0};
+        writeBytes(out, &header, sizeof(header));
+        size = sizeof(header);
+    }
+
+    return static_cast<bool>(out);
+}
+
+GameArchive::Writer::Writer(std::filesystem::path const& archivePath)
+{
+    uint64_t indexSize {0};
+    mIsOpen = openForAppend(mArchive, archivePath, ARCHIVE_MAGIC, mArchiveSize) &&
+              openForAppend(mIndex, getIndexPath(archivePath), INDEX_MAGIC, indexSize, sizeof(uint64_t));
+}
+
+bool GameArchive::Writer::append(std::string_view const startingFEN, std::span<PackedMove const> const moves,
+    Result const result, int64_t const unixTime)
+{
+    if( ! mIsOpen || startingFEN.size() > UINT16_MAX || moves.size() > UINT32_MAX )
+        return false;
+
+    static constexpr std::array<char, 8> zeros {};
+
+    //a record that was cut short (by a crash) can leave the archive off the 8 byte boundary
+    if(auto const misalignment {mArchiveSize % 8})
+    {
+        writeBytes(mArchive, zeros.data(), 8 - misalignment);
+        mArchiveSize += 8 - misalignment;
+    }
+
+    uint64_t const offset {mArchiveSize};
+    GameHeader const header {static_cast<uint32_t>(moves.size()), static_cast<uint16_t>(startingFEN.size()), result, 0, unixTime};
+    size_t const fenSize {(startingFEN.size() + 1) & ~size_t{1}};
+    size_t const recordSize {sizeof(header) + fenSize + moves.size_bytes()};
+
+    writeBytes(mArchive, &header, sizeof(header));
+    writeBytes(mArchive, startingFEN.data(), startingFEN.size());
+    writeBytes(mArchive, zeros.data(), fenSize - startingFEN.size());
+    writeBytes(mArchive, moves.data(), moves.size_bytes());
+    mArchive.flush();
+    if( ! mArchive )
+    {
+        mIsOpen = false;
+        return false;
+    }
+    mArchiveSize += recordSize;
+
+    //only now that the record is in the archive can the index point to it
+    writeBytes(mIndex, &offset, sizeof(offset));
+    mIndex.flush();
+    if( ! mIndex )
+        mIsOpen = false;
+
+    return mIsOpen;
+}
+
+GameArchive::Reader::Reader(MappedFile archive, MappedFile index)
+    : mArchive{std::move(archive)},
+      mIndex{std::move(index)}
+{
+    auto const indexBytes {mIndex.getBytes().subspan(sizeof(FileHeader))};
+    mOffsets = {reinterpret_cast<uint64_t const*>(indexBytes.data()), indexBytes.size() / sizeof(uint64_t)};
+}
+
+static bool hasHeader(std::span<std::byte const> const bytes, std::array<char, 8> const& magic)
+{
+    GameArchive::FileHeader header {};
+    if(bytes.size() < sizeof(header))
+        return false;
+
+    std::memcpy(&header, bytes.data(), sizeof(header));
+    return header.magic == magic && header.version == GameArchive::VERSION;
+}
+
+std::expected<GameArchive::Reader, std::string> GameArchive::Reader::open(std::filesystem::path const& archivePath)
+{
+    auto archive {MappedFile::open(archivePath)};
+    if( ! archive )
+        return std::unexpected{archive.error()};
+
+    auto index {MappedFile::open(getIndexPath(archivePath))};
+    if( ! index )
+        return std::unexpected{index.error()};
+
+    if( ! hasHeader(archive->getBytes(), ARCHIVE_MAGIC) )
+        return std::unexpected{archivePath.string() + " isn't a version " + std::to_string(VERSION) + " game archive"};
+
+    if( ! hasHeader(index->getBytes(), INDEX_MAGIC) )
+        return std::unexpected{getIndexPath(archivePath).string() + " isn't a version " + std::to_string(VERSION) + " game archive index"};
+
+    return Reader{std::move(*archive), std::move(*index)};
+}
+
+std::optional<GameArchive::Game> GameArchive::Reader::getGame(size_t const index) const
+{
+    auto const bytes {mArchive.getBytes()};
+    uint64_t const offset {mOffsets[index]};
+
+    if(offset % 8 != 0 || offset > bytes.size() || bytes.size() - offset < sizeof(GameHeader))
+        return std::nullopt;
+
+    auto const& header {*reinterpret_cast<GameHeader const*>(bytes.data() + offset)};
+    size_t const fenSize {(size_t{header.fenLength} + 1) & ~size_t{1}};
+    if(bytes.size() - offset - sizeof(GameHeader) < fenSize + size_t{header.numMoves} * sizeof(PackedMove))
+        return std::nullopt;
+
+    auto const fen {reinterpret_cast<char const*>(bytes.data() + offset + sizeof(GameHeader))};
+    auto const moves {reinterpret_cast<PackedMove const*>(fen + fenSize)};
+
+    return Game
+    {
+        .result = header.result,
+        .unixTime = header.unixTime,
+        .startingFEN = {fen, header.fenLength},
+        .moves = {moves, header.numMoves}
+    };
+}
+
+void GameArchive::Reader::adviseSequential() const
+{
+    mArchive.adviseSequential();
+    mIndex.adviseSequential();
+}
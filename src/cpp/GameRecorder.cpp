@@ -0,0 +1,70 @@
+#include "GameRecorder.hpp"
+#include "Board.hpp"
+#include "errorLogger.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+
+GameRecorder::GameRecorder(Board const& board, BoardEventSystem::Subscriber& boardEventSubscriber, std::filesystem::path pgnFilePath,
+    std::filesystem::path const& archiveFilePath)
+    : mBoard{board},
+      mBoardEventSubscriber{boardEventSubscriber},
+      mPGNFilePath{std::move(pgnFilePath)},
+      mArchiveWriter{archiveFilePath}
+{
+    if( ! mArchiveWriter.isOpen() )
+        FileErrorLogger::get().log("could not open the game archive ", archiveFilePath.string(), " (games won't be archived)");
+
+    mGameOverSubID = mBoardEventSubscriber.sub<BoardEvents::GameOver>(
+        [this](Event const& e){ onGameOver(e.unpack<BoardEvents::GameOver>()); });
+}
+
+GameRecorder::~GameRecorder()
+{
+    mBoardEventSubscriber.unsub<BoardEvents::GameOver>(mGameOverSubID);
+}
+
+void GameRecorder::onGameOver(BoardEvents::GameOver const& evnt)
+{
+    mGame.clear();
+
+    //The game is over on the Board's last move, so it is either checkmate (the side to move lost) or a draw.
+    bool const isCheckmate {mBoard.getLegalMoves().empty() && mBoard.getCheckState() != Board::CheckType::NO_CHECK};
+    mGame.result = ! isCheckmate ? "1/2-1/2" : mBoard.getWhosTurnItIs() == Side::WHITE ? "0-1" : "1-0";
+
+    auto const now {std::chrono::system_clock::now()};
+    auto const today {std::chrono::year_month_day{std::chrono::floor<std::chrono::days>(now)}};
+    char date[16];
+    std::snprintf(date, sizeof(date), "%04d.%02u.%02u", static_cast<int>(today.year()),
+        static_cast<unsigned>(today.month()), static_cast<unsigned>(today.day()));
+
+    //only an online game or a game against the engine has a side that is the user's
+    auto const userSide {mBoard.getSideUserIsPlayingAs()};
+    mGame.setTag("Event", "Casual game");
+    mGame.setTag("Date", date);
+    mGame.setTag("White", userSide == Side::INVALID ? "?" : userSide == Side::WHITE ? "Player" : "Opponent");
+    mGame.setTag("Black", userSide == Side::INVALID ? "?" : userSide == Side::BLACK ? "Player" : "Opponent");
+    mGame.setTag("Termination", evnt.reason);
+
+    mGame.startingFEN = mBoard.getStartingFEN();
+    std::ranges::copy(mBoard.getMoveHistory(), std::back_inserter(mGame.moves));
+
+    if(std::ofstream pgnFile {mPGNFilePath, std::ios_base::app})
+        mPGNWriter.write(pgnFile, mGame);
+    else
+        FileErrorLogger::get().log("could not open ", mPGNFilePath.string(), " to record the game");
+
+    if(mArchiveWriter.isOpen())
+    {
+        bool const isStartPosition {mGame.startingFEN == TestPositions::defaultPositionFEN};
+        auto const unixTime {std::chrono::duration_cast<std::chrono::seconds>(now.time_since_epoch()).count()};
+
+        if( ! mArchiveWriter.append(isStartPosition ? std::string_view{} : mGame.startingFEN, mGame.moves,
+            GameArchive::toResult(mGame.result), unixTime) )
+        {
+            FileErrorLogger::get().log("could not add the game to the game archive");
+        }
+    }
+}
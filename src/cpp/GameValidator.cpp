@@ -0,0 +1,125 @@
+#include "GameValidator.hpp"
+#include "PGN.hpp"
+#include "ProtocolCodec.hpp"
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+//How many games a thread claims at a time. Big enough that the threads rarely touch the shared counter,
+//small enough that they all finish at about the same time.
+static constexpr size_t GAMES_PER_CLAIM {64};
+
+std::optional<GameError> GameValidator::findFirstError(RecordedGame const& game)
+{
+    //checked here first (like PGNReader does) so that a file full of broken FENs doesn't end up in the error log
+    auto const parsed {FENCodec::parse(game.startingFEN)};
+    if( ! parsed )
+        return GameError{.type = GameError::Type::BAD_FEN, .fenError = parsed.error()};
+
+    mBoard.setPosition(game.startingFEN, *parsed);
+
+    //setPosition() has already updated the legal moves for the first one
+    for(size_t i = 0; i < game.moves.size(); ++i)
+    {
+        if(i > 0)
+            mBoard.updateLegalMoves();
+
+        if( ! mBoard.isLegalMove(game.moves[i]) )
+            return GameError{.type = GameError::Type::ILLEGAL_MOVE, .moveIdx = i};
+
+        mBoard.makeMove(game.moves[i]);
+    }
+
+    return std::nullopt;
+}
+
+std::vector<std::optional<GameError>> GameValidator::validateGames(std::span<RecordedGame const> const games, int const numThreads)
+{
+    std::vector<std::optional<GameError>> results(games.size());
+    std::atomic<size_t> nextGame {0};
+
+    //each thread writes to the results of the games it claimed only, so nothing else is shared
+    auto const validateClaimedGames = [&]
+    {
+        GameValidator validator;
+        for(size_t first {nextGame.fetch_add(GAMES_PER_CLAIM)}; first < games.size(); first = nextGame.fetch_add(GAMES_PER_CLAIM))
+        {
+            size_t const last {std::min(first + GAMES_PER_CLAIM, games.size())};
+            for(size_t i = first; i < last; ++i)
+                results[i] = validator.findFirstError(games[i]);
+        }
+    };
+
+    std::vector<std::jthread> helpers;
+    for(int i = 1; i < numThreads; ++i)
+        helpers.emplace_back(validateClaimedGames);
+
+    validateClaimedGames();
+    helpers.clear(); //joins
+
+    return results;
+}
+
+std::vector<RecordedGame> GameValidator::parseMessageStream(std::span<std::byte const> stream)
+{
+    std::vector<RecordedGame> games(1);
+
+    while( ! stream.empty() )
+    {
+        //framed the same way ConnectionManager::processNetworkMessages() does it, so a header that doesn't match
+        //its type's size in chessNetworkProtocol.h ends the stream instead of swallowing the messages after it
+        bool const hasValidHeader
+        {
+            stream.size() >= ProtocolCodec::HEADER_SIZE && ProtocolCodec::isValidHeader(stream[0], stream[1])
+        };
+        size_t const msgSize {hasValidHeader ? std::to_integer<size_t>(stream[1]) : 0};
+        if( ! hasValidHeader || msgSize > stream.size() )
+        {
+            games.back().moves.push_back(PackedMove{});
+            break;
+        }
+
+        auto const msg {stream.first(msgSize)};
+        stream = stream.subspan(msgSize);
+
+        switch(static_cast<MessageType>(msg[0]))
+        {
+        case MessageType::MOVE_MSGTYPE:
+            games.back().moves.push_back(ProtocolCodec::decodeMoveMessage(msg).value_or(PackedMove{}));
+            break;
+
+        //a game with no moves yet is the one being started, so it is reused instead of leaving an empty game behind
+        case MessageType::PAIRING_COMPLETE_MSGTYPE:
+        case MessageType::REMATCH_ACCEPT_MSGTYPE:
+            if( ! games.back().moves.empty() )
+                games.emplace_back();
+            break;
+
+        default:
+            break;
+        }
+    }
+
+    if(games.back().moves.empty())
+        games.pop_back();
+
+    return games;
+}
+
+std::vector<RecordedGame> GameValidator::parsePGN(std::istream& in)
+{
+    std::vector<RecordedGame> games;
+    PGNReader reader {in};
+    PGNGame game;
+
+    while(reader.readGame(game))
+    {
+        RecordedGame& recorded {games.emplace_back(game.startingFEN, game.moves)};
+
+        //PGNReader stops at the move it couldn't play (there are no moves after a bad FEN tag anyway)
+        if(game.error)
+            recorded.moves.push_back(PackedMove{});
+    }
+
+    return games;
+}
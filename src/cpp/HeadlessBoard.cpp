@@ -0,0 +1,7 @@
+#include "HeadlessBoard.hpp"
+
+HeadlessBoard::HeadlessBoard()
+    : Board {boardEventSys.getPublisher(), guiEventSys.getSubscriber(), networkEventSys.getSubscriber(),
+        appEventSys.getSubscriber(), engineEventSys.getSubscriber()}
+{
+}
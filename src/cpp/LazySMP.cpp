@@ -0,0 +1,77 @@
+#include "LazySMP.hpp"
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+LazySMP::LazySMP(TranspositionTable& transpositionTable, int const numThreads)
+    : mTranspositionTable{transpositionTable}
+{
+    setNumThreads(numThreads);
+    mMoves.reserve(256);
+}
+
+void LazySMP::setNumThreads(int numThreads)
+{
+    numThreads = std::max(numThreads, 1);
+
+    mSearches.clear();
+    for(int i = 0; i < numThreads; ++i)
+        mSearches.push_back(std::make_unique<Search>(mTranspositionTable, i));
+
+    mResults.resize(static_cast<size_t>(numThreads));
+}
+
+void LazySMP::setPosition(std::string_view const fen, std::span<PackedMove const> const moves)
+{
+    mFEN = fen;
+    mMoves.assign(moves.begin(), moves.end());
+}
+
+LazySMP::Result LazySMP::run(SearchLimits const& limits, std::stop_token stopToken)
+{
+    auto const start {std::chrono::steady_clock::now()};
+    mTranspositionTable.newSearch();
+
+    //The helpers only stop at the depth limit or when the main thread is done.
+    SearchLimits const helperLimits {.maxDepth = limits.maxDepth};
+    std::stop_source helperStopSource;
+
+    std::vector<std::jthread> helpers;
+    helpers.reserve(mSearches.size() - 1);
+
+    for(size_t i = 1; i < mSearches.size(); ++i)
+    {
+        helpers.emplace_back([this, i, &helperLimits, token = helperStopSource.get_token()]
+        {
+            mSearches[i]->setPosition(mFEN, mMoves);
+            mResults[i] = mSearches[i]->run(helperLimits, token);
+        });
+    }
+
+    mSearches[0]->setPosition(mFEN, mMoves);
+    mResults[0] = mSearches[0]->run(limits, std::move(stopToken));
+
+    helperStopSource.request_stop();
+    helpers.clear(); //joins
+
+    std::chrono::duration<double> const elapsed {std::chrono::steady_clock::now() - start};
+
+    Result result
+    {
+        .mainThreadResult = mResults[0],
+        .nodesPerThread = {},
+        .totalNodes = 0,
+        .totalTTProbes = 0,
+        .totalTTHits = 0,
+        .seconds = elapsed.count()
+    };
+    for(auto const& threadResult : mResults)
+    {
+        result.nodesPerThread.push_back(threadResult.nodes);
+        result.totalNodes += threadResult.nodes;
+        result.totalTTProbes += threadResult.ttProbes;
+        result.totalTTHits += threadResult.ttHits;
+    }
+
+    return result;
+}
@@ -0,0 +1,134 @@
+#include "MappedFile.hpp"
+#include <cerrno>
+#include <cstring>
+#include <utility>
+
+#ifdef _WIN32
+    #ifndef NOMINMAX
+        #define NOMINMAX
+    #endif
+    #include <Windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+#ifdef _WIN32
+
+std::expected<MappedFile, std::string> MappedFile::open(std::filesystem::path const& path)
+{
+    HANDLE const file {CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr,
+        OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr)};
+    if(file == INVALID_HANDLE_VALUE)
+        return std::unexpected{"could not open " + path.string()};
+
+    LARGE_INTEGER size {};
+    if( ! GetFileSizeEx(file, &size) )
+    {
+        CloseHandle(file);
+        return std::unexpected{"could not get the size of " + path.string()};
+    }
+
+    MappedFile mapped;
+    if(size.QuadPart == 0)
+    {
+        CloseHandle(file);
+        return mapped;
+    }
+
+    //the view keeps the mapping (and the file) open, so neither handle is needed once it exists
+    HANDLE const mapping {CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr)};
+    CloseHandle(file);
+    if( ! mapping )
+        return std::unexpected{"could not map " + path.string()};
+
+    void const* const view {MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0)};
+    CloseHandle(mapping);
+    if( ! view )
+        return std::unexpected{"could not map " + path.string()};
+
+    mapped.mData = static_cast<std::byte const*>(view);
+    mapped.mSize = static_cast<size_t>(size.QuadPart);
+    return mapped;
+}
+
+void MappedFile::adviseSequential() const
+{
+}
+
+void MappedFile::unmap()
+{
+    if(mData)
+        UnmapViewOfFile(mData);
+}
+
+#else
+
+std::expected<MappedFile, std::string> MappedFile::open(std::filesystem::path const& path)
+{
+    int const fd {::open(path.c_str(), O_RDONLY)};
+    if(fd == -1)
+        return std::unexpected{"could not open " + path.string() + " (" + std::strerror(errno) + ")"};
+
+    struct stat status {};
+    if(fstat(fd, &status) == -1)
+    {
+        ::close(fd);
+        return std::unexpected{"could not get the size of " + path.string() + " (" + std::strerror(errno) + ")"};
+    }
+
+    MappedFile mapped;
+    if(status.st_size == 0)
+    {
+        ::close(fd);
+        return mapped;
+    }
+
+    //the mapping keeps the file open, so the descriptor isn't needed once it exists
+    void* const data {mmap(nullptr, static_cast<size_t>(status.st_size), PROT_READ, MAP_SHARED, fd, 0)};
+    ::close(fd);
+    if(data == MAP_FAILED)
+        return std::unexpected{"could not map " + path.string() + " (" + std::strerror(errno) + ")"};
+
+    mapped.mData = static_cast<std::byte const*>(data);
+    mapped.mSize = static_cast<size_t>(status.st_size);
+    return mapped;
+}
+
+void MappedFile::adviseSequential() const
+{
+    if(mData)
+        (void)madvise(const_cast<std::byte*>(mData), mSize, MADV_SEQUENTIAL);
+}
+
+void MappedFile::unmap()
+{
+    if(mData)
+        munmap(const_cast<std::byte*>(mData), mSize);
+}
+
+#endif
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+    : mData {std::exchange(other.mData, nullptr)},
+      mSize {std::exchange(other.mSize, 0)}
+{
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+{
+    if(this != &other)
+    {
+        unmap();
+        mData = std::exchange(other.mData, nullptr);
+        mSize = std::exchange(other.mSize, 0);
+    }
+    return *this;
+}
+
+MappedFile::~MappedFile()
+{
+    unmap();
+}
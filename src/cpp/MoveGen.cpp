@@ -0,0 +1,351 @@
+#include "MoveGen.hpp"
+#include "Attacks.hpp"
+#include "Board.hpp"
+#include "Position.hpp"
+#include <array>
+
+//Which kinds of moves generateMoves() adds. A stage is one or more of these.
+enum GenFlags : unsigned
+{
+    GEN_CAPTURES   = 1,
+    GEN_PROMOTIONS = 2,
+    GEN_QUIETS     = 4,
+    GEN_ALL        = GEN_CAPTURES | GEN_PROMOTIONS | GEN_QUIETS
+};
+
+//Everything about the position the generation functions below need, looked up once per generation.
+struct GenState
+{
+    Board const& board;
+    Position const& pos;
+    Side us;
+    Side them;
+    Bitboard enemy;
+    Bitboard occupied;
+    Square kingSq;
+    Bitboard checkers;
+    Bitboard pinned;
+};
+
+//b must have a king for the side to move.
+static GenState makeGenState(Board const& b)
+{
+    auto const& pos {b.getPosition()};
+    Side const us {b.getWhosTurnItIs()};
+    Side const them {us == Side::WHITE ? Side::BLACK : Side::WHITE};
+    Square const kingSq {pos.getKingSquare(us)};
+
+    return GenState
+    {
+        .board = b,
+        .pos = pos,
+        .us = us,
+        .them = them,
+        .enemy = pos.getPieces(them),
+        .occupied = pos.getOccupied(),
+        .kingSq = kingSq,
+        .checkers = b.getCheckers(),
+        .pinned = b.getPinnedPieces()
+    };
+}
+
+Bitboard MoveGen::getAttackersTo(Position const& pos, Square const sq, Side const attackingSide, Bitboard const occupied)
+{
+    using enum PieceTypes;
+    Side const defendingSide {attackingSide == Side::WHITE ? Side::BLACK : Side::WHITE};
+
+    Bitboard const queens {pos.getPieces(QUEEN)};
+    Bitboard const attackers
+    {
+        (Attacks::getRookAttacks(sq, occupied) & (pos.getPieces(ROOK) | queens)) |
+        (Attacks::getBishopAttacks(sq, occupied) & (pos.getPieces(BISHOP) | queens)) |
+        (Attacks::getKnightAttacks(sq) & pos.getPieces(KNIGHT)) |
+        (Attacks::getKingAttacks(sq) & pos.getPieces(KING)) |
+        //a pawn attacks sq if a pawn of the other side standing on sq would attack the pawn
+        (Attacks::getPawnAttacks(defendingSide, sq) & pos.getPieces(PAWN))
+    };
+
+    return attackers & pos.getPieces(attackingSide);
+}
+
+Bitboard MoveGen::getPinnedPieces(Position const& pos, Side const side)
+{
+    using enum PieceTypes;
+    Square const kingSq {pos.getKingSquare(side)};
+    if(kingSq == INVALID_SQUARE)
+        return 0;
+
+    Side const enemySide {side == Side::WHITE ? Side::BLACK : Side::WHITE};
+    Bitboard const queens {pos.getPieces(QUEEN)};
+    Bitboard const occupied {pos.getOccupied()};
+
+    //the enemy sliders that would attack the king on an empty board
+    Bitboard snipers
+    {
+        ((Attacks::getRookAttacks(kingSq, 0) & (pos.getPieces(ROOK) | queens)) |
+         (Attacks::getBishopAttacks(kingSq, 0) & (pos.getPieces(BISHOP) | queens))) & pos.getPieces(enemySide)
+    };
+
+    Bitboard pinned {0};
+    while(snipers)
+    {
+        Bitboard const blockers {Attacks::getSquaresBetween(kingSq, popLsb(snipers)) & occupied};
+        if(popCount(blockers) == 1)
+            pinned |= blockers & pos.getPieces(side);
+    }
+
+    return pinned;
+}
+
+//Where the piece on from may go without exposing its king: anywhere unless it's pinned,
+//in which case only along the line through its king and the pinner (capturing the pinner included).
+static Bitboard getPinMask(GenState const& gs, Square const from)
+{
+    return testSquare(gs.pinned, from) ? Attacks::getLine(gs.kingSq, from) : ~Bitboard{0};
+}
+
+//The king can't use the pins and check masks since it's the one moving, so each of its targets is checked
+//for attackers with the king taken off the board (it can't step back along the line of a slider checking it).
+static bool isKingMoveLegal(GenState const& gs, Square const to)
+{
+    Bitboard const occupied {gs.occupied & ~squareBB(gs.kingSq)};
+    return MoveGen::getAttackersTo(gs.pos, to, gs.them, occupied) == 0;
+}
+
+//En passant takes two pawns off the same rank at once, which can expose the king along that rank
+//in a way the pin mask doesn't see, so it's tested with the actual occupancy after the capture. It's rare enough not to matter.
+static bool isEnPassantLegal(Position const& pos, Square const kingSq, Side const them,
+    Square const from, Square const to, Square const capturedSq)
+{
+    Bitboard const captured {squareBB(capturedSq)};
+    Bitboard const occupied {((pos.getOccupied() & ~squareBB(from)) & ~captured) | squareBB(to)};
+
+    return (MoveGen::getAttackersTo(pos, kingSq, them, occupied) & ~captured) == 0;
+}
+
+bool MoveGen::canCaptureEnPassant(Position const& pos, Side const side, Square const epSq)
+{
+    Side const them {side == Side::WHITE ? Side::BLACK : Side::WHITE};
+    Square const kingSq {pos.getKingSquare(side)};
+
+    //the pawn that made the double push is just past the en passant square
+    Square const capturedSq {side == Side::WHITE ? epSq - 8 : epSq + 8};
+
+    //the side's pawns that attack the en passant square (which a pawn of the other side standing there would attack)
+    Bitboard capturers {Attacks::getPawnAttacks(them, epSq) & pos.getPieces(side, PieceTypes::PAWN)};
+    while(capturers)
+    {
+        Square const from {popLsb(capturers)};
+        if(kingSq == INVALID_SQUARE || isEnPassantLegal(pos, kingSq, them, from, epSq, capturedSq))
+            return true;
+    }
+
+    return false;
+}
+
+//Adds a move from from to every square in targets. targets must already be legal (see getPinMask()).
+static void addMoves(GenState const& gs, MoveList& out, Square const from, Bitboard targets)
+{
+    while(targets)
+    {
+        Square const to {popLsb(targets)};
+        bool const isCapture {testSquare(gs.enemy, to)};
+        out.push_back(PackedMove{from, to, isCapture ? PackedMove::CAPTURE : PackedMove::QUIET});
+    }
+}
+
+static void addPromotions(GenState const& gs, MoveList& out, Square const from, Square const to)
+{
+    bool const isCapture {testSquare(gs.enemy, to)};
+
+    using enum ChessMove::PromoTypes;
+    for(auto const promoType : {QUEEN, ROOK, KNIGHT, BISHOP})
+        out.push_back(PackedMove::makePromotion(from, to, promoType, isCapture));
+}
+
+//mask is where the pawns are allowed to land (every square unless in check). An en passant capture
+//is allowed by mask if either the landing square or the captured pawn is in it.
+//The pin mask is folded into mask per pawn, so every move found is legal with a single AND.
+static void addPawnMoves(GenState const& gs, MoveList& out, unsigned const flags, Bitboard const mask)
+{
+    int const forward {gs.us == Side::WHITE ? 8 : -8};
+    Bitboard const promotionRank {gs.us == Side::WHITE ? RANK_8_BB : RANK_1_BB};
+    int const startRank {gs.us == Side::WHITE ? 1 : 6};
+
+    Square const epSq {gs.board.isEnPassantAvailable() ? toSquare(gs.board.getEnPassantLocation()) : INVALID_SQUARE};
+
+    Bitboard pawns {gs.pos.getPieces(gs.us, PieceTypes::PAWN)};
+    while(pawns)
+    {
+        Square const from {popLsb(pawns)};
+        Bitboard const allowed {mask & getPinMask(gs, from)};
+        Bitboard const captures {Attacks::getPawnAttacks(gs.us, from) & gs.enemy & allowed};
+
+        Square const oneInFront {from + forward};
+        bool const isOneInFrontEmpty { ! testSquare(gs.occupied, oneInFront) };
+
+        if(testSquare(promotionRank, oneInFront))
+        {
+            if( ! (flags & GEN_PROMOTIONS) )
+                continue;
+
+            if(isOneInFrontEmpty && testSquare(allowed, oneInFront))
+                addPromotions(gs, out, from, oneInFront);
+
+            for(Bitboard bb {captures}; bb;)
+                addPromotions(gs, out, from, popLsb(bb));
+
+            continue;
+        }
+
+        if(flags & GEN_QUIETS && isOneInFrontEmpty)
+        {
+            if(testSquare(allowed, oneInFront))
+                out.push_back(PackedMove{from, oneInFront, PackedMove::QUIET});
+
+            Square const twoInFront {oneInFront + forward};
+            if(from / 8 == startRank && ! testSquare(gs.occupied, twoInFront) && testSquare(allowed, twoInFront))
+            {
+                out.push_back(PackedMove{from, twoInFront, PackedMove::DOUBLE_PUSH});
+            }
+        }
+
+        if(flags & GEN_CAPTURES)
+        {
+            for(Bitboard bb {captures}; bb;)
+                out.push_back(PackedMove{from, popLsb(bb), PackedMove::CAPTURE});
+
+            //the pawn being taken en passant is beside the capturing pawn, not on the en passant square.
+            //Removing both pawns from the rank at once is what can leave the king in check along it.
+            if(epSq != INVALID_SQUARE && testSquare(Attacks::getPawnAttacks(gs.us, from), epSq))
+            {
+                Square const capturedSq {epSq - forward};
+                if((mask & (squareBB(epSq) | squareBB(capturedSq))) && isEnPassantLegal(gs.pos, gs.kingSq, gs.them, from, epSq, capturedSq))
+                    out.push_back(PackedMove{from, epSq, PackedMove::EN_PASSANT});
+            }
+        }
+    }
+}
+
+static Bitboard getPieceAttacks(PieceTypes const type, Square const sq, Bitboard const occupied)
+{
+    switch(type)
+    {
+    case PieceTypes::KNIGHT: return Attacks::getKnightAttacks(sq);
+    case PieceTypes::BISHOP: return Attacks::getBishopAttacks(sq, occupied);
+    case PieceTypes::ROOK:   return Attacks::getRookAttacks(sq, occupied);
+    case PieceTypes::QUEEN:  return Attacks::getQueenAttacks(sq, occupied);
+    default: return 0;
+    }
+}
+
+static void addCastles(GenState const& gs, MoveList& out)
+{
+    //castling out of check isn't allowed (and generateMoves() is only asked for quiets when not in check)
+    if(gs.checkers)
+        return;
+
+    bool const isWhite {gs.us == Side::WHITE};
+
+    //The squares between the king and the rook have to be empty,
+    //and the king can't pass over or land on an attacked square.
+    auto const tryCastle = [&](CastleRights::Rights const rights, int const direction, int const emptyCount)
+    {
+        if( ! gs.board.hasCastleRights(rights) )
+            return;
+
+        for(int i = 1; i <= emptyCount; ++i)
+        {
+            if(testSquare(gs.occupied, gs.kingSq + direction * i))
+                return;
+        }
+
+        for(int i = 1; i <= 2; ++i)
+        {
+            if(MoveGen::getAttackersTo(gs.pos, gs.kingSq + direction * i, gs.them, gs.occupied))
+                return;
+        }
+
+        out.push_back(PackedMove{gs.kingSq, gs.kingSq + direction * 2, PackedMove::CASTLE});
+    };
+
+    tryCastle(isWhite ? CastleRights::Rights::WSHORT : CastleRights::Rights::BSHORT, 1, 2);
+    tryCastle(isWhite ? CastleRights::Rights::WLONG : CastleRights::Rights::BLONG, -1, 3);
+}
+
+//mask is where the pieces other than the king are allowed to move to (see the EVASIONS stage).
+static void generateMoves(GenState const& gs, MoveList& out, unsigned const flags, Bitboard const mask)
+{
+    addPawnMoves(gs, out, flags, mask);
+
+    Bitboard targets {0};
+    if(flags & GEN_CAPTURES) targets |= gs.enemy;
+    if(flags & GEN_QUIETS)   targets |= ~gs.occupied;
+
+    if( ! targets )
+        return;
+
+    using enum PieceTypes;
+    for(auto const type : {KNIGHT, BISHOP, ROOK, QUEEN})
+    {
+        Bitboard pieces {gs.pos.getPieces(gs.us, type)};
+        while(pieces)
+        {
+            Square const from {popLsb(pieces)};
+            addMoves(gs, out, from, getPieceAttacks(type, from, gs.occupied) & targets & mask & getPinMask(gs, from));
+        }
+    }
+
+    Bitboard kingTargets {Attacks::getKingAttacks(gs.kingSq) & targets};
+    while(kingTargets)
+    {
+        Square const to {popLsb(kingTargets)};
+        if(isKingMoveLegal(gs, to))
+            out.push_back(PackedMove{gs.kingSq, to, testSquare(gs.enemy, to) ? PackedMove::CAPTURE : PackedMove::QUIET});
+    }
+
+    if(flags & GEN_QUIETS)
+        addCastles(gs, out);
+}
+
+//In check the pieces other than the king can only capture a lone checker or block it.
+//In double check (more than one checker) only the king can move.
+static void generateEvasions(GenState const& gs, MoveList& out)
+{
+    Bitboard mask {0};
+    if(popCount(gs.checkers) == 1)
+        mask = gs.checkers | Attacks::getSquaresBetween(gs.kingSq, lsb(gs.checkers));
+
+    generateMoves(gs, out, GEN_ALL, mask);
+}
+
+void MoveGen::generate(Board const& b, Stage const stage, MoveList& out)
+{
+    //no king means a broken position (Board logs it when loading the FEN) which has no legal moves
+    if(b.getPosition().getKingSquare(b.getWhosTurnItIs()) == INVALID_SQUARE)
+        return;
+
+    auto const gs {makeGenState(b)};
+
+    switch(stage)
+    {
+    case Stage::CAPTURES:   generateMoves(gs, out, GEN_CAPTURES, ~Bitboard{0}); break;
+    case Stage::PROMOTIONS: generateMoves(gs, out, GEN_PROMOTIONS, ~Bitboard{0}); break;
+    case Stage::QUIETS:     generateMoves(gs, out, GEN_QUIETS, ~Bitboard{0}); break;
+    case Stage::EVASIONS:   generateEvasions(gs, out); break;
+    }
+}
+
+void MoveGen::generateLegalMoves(Board const& b, MoveList& out)
+{
+    out.clear();
+    if(b.getPosition().getKingSquare(b.getWhosTurnItIs()) == INVALID_SQUARE)
+        return;
+
+    auto const gs {makeGenState(b)};
+
+    if(gs.checkers)
+        generateEvasions(gs, out);
+    else
+        generateMoves(gs, out, GEN_ALL, ~Bitboard{0});
+}
@@ -0,0 +1,360 @@
+#include "PGN.hpp"
+#include "FENCodec.hpp"
+#include "SANCodec.hpp"
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cstdio>
+
+static constexpr std::array<std::string_view, 7> s_sevenTagRoster {"Event", "Site", "Date", "Round", "White", "Black", "Result"};
+
+//export format lines are at most 79 characters long
+static constexpr size_t MAX_LINE_LENGTH {79};
+
+std::string_view PGNGame::getTag(std::string_view const name) const
+{
+    auto const it {std::ranges::find(tags, name, &PGNTag::name)};
+    return it == tags.end() ? std::string_view{} : std::string_view{it->value};
+}
+
+void PGNGame::setTag(std::string_view const name, std::string_view const value)
+{
+    auto const it {std::ranges::find(tags, name, &PGNTag::name)};
+    if(it == tags.end())
+        tags.push_back(PGNTag{std::string{name}, std::string{value}});
+    else
+        it->value = value;
+}
+
+void PGNGame::clear()
+{
+    tags.clear();
+    startingFEN = TestPositions::defaultPositionFEN;
+    moves.clear();
+    result = "*";
+    error.reset();
+}
+
+PGNWriter::PGNWriter()
+{
+    mLine.reserve(MAX_LINE_LENGTH + 1);
+}
+
+static void writeTag(std::ostream& out, std::string_view const name, std::string_view const value)
+{
+    out << '[' << name << " \"";
+    for(char const c : value)
+    {
+        if(c == '"' || c == '\\')
+            out << '\\';
+        out << c;
+    }
+    out << "\"]\n";
+}
+
+void PGNWriter::write(std::ostream& out, PGNGame const& game)
+{
+    for(auto const name : s_sevenTagRoster)
+    {
+        auto value {name == "Result" ? std::string_view{game.result} : game.getTag(name)};
+        if(value.empty())
+            value = name == "Date" ? "????.??.??" : "?";
+
+        writeTag(out, name, value);
+    }
+
+    if(game.startingFEN != TestPositions::defaultPositionFEN)
+    {
+        writeTag(out, "SetUp", "1");
+        writeTag(out, "FEN", game.startingFEN);
+    }
+
+    for(auto const& tag : game.tags)
+    {
+        if(std::ranges::find(s_sevenTagRoster, tag.name) == s_sevenTagRoster.end() && tag.name != "SetUp" && tag.name != "FEN")
+            writeTag(out, tag.name, tag.value);
+    }
+
+    out << '\n';
+
+    mLine.clear();
+    auto const putToken = [&](std::string_view const token)
+    {
+        if( ! mLine.empty() && mLine.size() + 1 + token.size() > MAX_LINE_LENGTH )
+        {
+            out << mLine << '\n';
+            mLine.clear();
+        }
+
+        if( ! mLine.empty() )
+            mLine.push_back(' ');
+        mLine.append(token);
+    };
+
+    //with no position to play them in none of the moves can be written
+    if(mBoard.setPosition(game.startingFEN))
+    {
+        std::array<char, 16> number;
+        std::array<char, SANCodec::MAX_LENGTH> san;
+
+        for(size_t i = 0; i < game.moves.size(); ++i)
+        {
+            //white's moves are numbered, and so is black's first move when the game starts with black to move
+            bool const isWhiteToMove {mBoard.getWhosTurnItIs() == Side::WHITE};
+            if(isWhiteToMove || i == 0)
+            {
+                auto const [end, ec] {std::to_chars(number.data(), number.data() + 8, mBoard.getFullmoveNumber())};
+                auto const dots {isWhiteToMove ? std::string_view{"."} : std::string_view{"..."}};
+                auto const numberEnd {std::ranges::copy(dots, end).out};
+                putToken({number.data(), numberEnd});
+            }
+
+            putToken(SANCodec::write(mBoard, game.moves[i], san));
+            mBoard.makeMove(game.moves[i]);
+        }
+    }
+
+    putToken(game.result);
+    out << mLine << "\n\n";
+}
+
+PGNReader::PGNReader(std::istream& in)
+    : mIn {in},
+      mChunk(CHUNK_SIZE)
+{
+    mToken.reserve(64);
+}
+
+int PGNReader::peek()
+{
+    if(mChunkPos == mChunkEnd)
+    {
+        mIn.read(mChunk.data(), static_cast<std::streamsize>(mChunk.size()));
+        mChunkEnd = static_cast<size_t>(mIn.gcount());
+        mChunkPos = 0;
+
+        if(mChunkEnd == 0)
+            return EOF;
+    }
+
+    return static_cast<unsigned char>(mChunk[mChunkPos]);
+}
+
+int PGNReader::get()
+{
+    int const c {peek()};
+    if(c == EOF)
+        return EOF;
+
+    ++mChunkPos;
+    mIsAtLineStart = c == '\n';
+    if(c == '\n')
+        ++mLineNumber;
+
+    return c;
+}
+
+static bool isSpace(int const c)
+{
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\f' || c == '\v';
+}
+
+//The characters that can't be part of a SAN move, move number or result.
+static bool endsToken(int const c)
+{
+    return c == EOF || isSpace(c) || std::string_view{"[]{}();"}.find(static_cast<char>(c)) != std::string_view::npos;
+}
+
+void PGNReader::readToken()
+{
+    mToken.clear();
+    while( ! endsToken(peek()) )
+        mToken.push_back(static_cast<char>(get()));
+}
+
+void PGNReader::skipUntil(char const end)
+{
+    int c {get()};
+    while(c != EOF && c != end)
+        c = get();
+}
+
+//Called after the opening bracket. Variations can be nested and can have comments with brackets in them.
+void PGNReader::skipVariation()
+{
+    int depth {1};
+    while(depth > 0)
+    {
+        switch(get())
+        {
+        case EOF: return;
+        case '(': ++depth; break;
+        case ')': --depth; break;
+        case '{': skipUntil('}'); break;
+        case ';': skipUntil('\n'); break;
+        default: break;
+        }
+    }
+}
+
+//Called after the [ of  [Name "value"]. A tag that doesn't look like that is read as far as it goes.
+void PGNReader::readTag(PGNGame& game)
+{
+    auto& tag {game.tags.emplace_back()};
+
+    while(peek() == ' ' || peek() == '\t')
+        get();
+
+    while( ! endsToken(peek()) && peek() != '"' )
+        tag.name.push_back(static_cast<char>(get()));
+
+    while(peek() == ' ' || peek() == '\t')
+        get();
+
+    //a value missing its closing quote stops before the end of the line, so the line after it isn't lost
+    if(peek() == '"')
+    {
+        get();
+        while(peek() != EOF && peek() != '"' && peek() != '\n')
+        {
+            int c {get()};
+            if(c == '\\' && (peek() == '"' || peek() == '\\'))
+                c = get();
+            tag.value.push_back(static_cast<char>(c));
+        }
+
+        if(peek() == '"')
+            get();
+    }
+
+    //the rest of the tag, without going on to the next line if the ] is missing
+    while(peek() != EOF && peek() != '\n' && get() != ']') {}
+}
+
+bool PGNReader::startMovetext(PGNGame& game)
+{
+    if(auto const fen {game.getTag("FEN")}; ! fen.empty())
+        game.startingFEN = fen;
+
+    //checked here first so that a database full of broken FENs doesn't end up in the error log
+    auto const parsed {FENCodec::parse(game.startingFEN)};
+    if( ! parsed )
+    {
+        game.error = PGNError{mLineNumber, "FEN tag can't be parsed", game.startingFEN};
+        return false;
+    }
+
+    mBoard.setPosition(game.startingFEN, *parsed);
+    return true;
+}
+
+static bool isResult(std::string_view const token)
+{
+    return token == "1-0" || token == "0-1" || token == "1/2-1/2" || token == "*";
+}
+
+bool PGNReader::readGame(PGNGame& game)
+{
+    game.clear();
+
+    bool hasStarted {false};   //has any of the game been read
+    bool isInMovetext {false}; //has the first token after the tags been read
+
+    while(true)
+    {
+        int const c {peek()};
+        if(c == EOF)
+            break;
+
+        //closing brackets without an opening one are skipped over like whitespace
+        if(isSpace(c) || c == ')' || c == ']' || c == '}')
+        {
+            get();
+            continue;
+        }
+
+        //escape lines (% at the start of a line) and rest of line comments
+        if((c == '%' && mIsAtLineStart) || c == ';')
+        {
+            skipUntil('\n');
+            continue;
+        }
+
+        if(c == '{')
+        {
+            skipUntil('}');
+            continue;
+        }
+
+        if(c == '(')
+        {
+            get();
+            skipVariation();
+            continue;
+        }
+
+        if(c == '[')
+        {
+            //a game without a result, which ends where the tags of the next one start
+            if(isInMovetext)
+                return true;
+
+            get();
+            readTag(game);
+            hasStarted = true;
+            continue;
+        }
+
+        readToken();
+        hasStarted = true;
+
+        //every character that ends a token is dealt with above, but the stream always has to move forward
+        if(mToken.empty())
+        {
+            get();
+            continue;
+        }
+
+        if( ! isInMovetext )
+        {
+            isInMovetext = true;
+            (void)startMovetext(game);
+        }
+
+        if(isResult(mToken))
+        {
+            game.result = mToken;
+            return true;
+        }
+
+        //NAGs ($1) and moves after one that couldn't be played
+        if(mToken.front() == '$' || game.error)
+            continue;
+
+        //a move number (12. or 12...) can be on its own or stuck to the move after it
+        std::string_view san {mToken};
+        auto const digitsEnd {std::min(san.find_first_not_of("0123456789"), san.size())};
+        if(digitsEnd == san.size())
+            continue;
+        if(digitsEnd > 0 && san[digitsEnd] == '.')
+            san.remove_prefix(std::min(san.find_first_not_of('.', digitsEnd), san.size()));
+        if(san.empty())
+            continue;
+
+        auto const move {SANCodec::parse(mBoard, san)};
+        if( ! move )
+        {
+            game.error = PGNError{mLineNumber, "illegal or ambiguous move", std::string{san}};
+            continue;
+        }
+
+        game.moves.push_back(*move);
+        mBoard.makeMove(*move);
+    }
+
+    //a game at the end of the stream without a result
+    if(hasStarted && ! isInMovetext)
+        (void)startMovetext(game);
+
+    return hasStarted;
+}
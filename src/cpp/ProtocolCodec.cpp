@@ -0,0 +1,85 @@
+#include "ProtocolCodec.hpp"
+
+// |0|1|2|3|4|5|6|7|8|9|
+//byte 0 will be the MOVE_MSGTYPE  <--- header bytes
+//byte 1 will be the MOVE_MSGSIZE  <---
+//
+//byte 2 will be the file (0-7) the piece if moving from   <--- source square
+//byte 3 will be the rank (0-7) the piece if moving from   <---
+// 
+//byte 4 will be the file (0-7) the piece if moving to   <--- destination square
+//byte 5 will be the rank (0-7) the piece if moving to   <---
+// 
+//byte 6 will be the ChessMove::PromoTypes of the promotion if there is one
+//byte 7 will be the ChessMove::MoveTypes
+//byte 8 will be the ChessMove::rightsToRevoke as an unsigned char
+//byte 9 will be the ChessMove::wasCapture bool
+//
+//Everything in the message can be worked out from a PackedMove, so the rights to revoke are never
+//read back out of byte 8 (they are worked out from the squares, see PackedMove::getRightsToRevoke()).
+auto ProtocolCodec::toMoveMsg(PackedMove const move) -> MoveMsg
+{
+    return MoveMsg
+    {
+        .fromFile       = static_cast<uint8_t>(move.getFrom() % 8),
+        .fromRank       = static_cast<uint8_t>(move.getFrom() / 8),
+        .toFile         = static_cast<uint8_t>(move.getTo() % 8),
+        .toRank         = static_cast<uint8_t>(move.getTo() / 8),
+        .promoType      = static_cast<uint8_t>(move.getPromoType()),
+        .moveType       = static_cast<uint8_t>(move.getMoveType()),
+        .rightsToRevoke = static_cast<uint8_t>(move.getRightsToRevoke().getRights()),
+        .wasCapture     = static_cast<uint8_t>(move.isCapture())
+    };
+}
+
+std::optional<PackedMove> ProtocolCodec::toPackedMove(MoveMsg const& msg)
+{
+    bool const isPromotion {msg.moveType == static_cast<uint8_t>(ChessMove::MoveTypes::PROMOTION)};
+    bool const hasPromoType {msg.promoType != static_cast<uint8_t>(ChessMove::PromoTypes::INVALID)};
+
+    //& rather than && so every check is done without branching on the ones before it
+    bool const isValid
+    {(
+        (msg.fromFile < 8) & (msg.fromRank < 8) & (msg.toFile < 8) & (msg.toRank < 8) & //squares have to be on the board
+        (msg.promoType <= static_cast<uint8_t>(ChessMove::PromoTypes::BISHOP)) &
+        (msg.moveType <= static_cast<uint8_t>(ChessMove::MoveTypes::PROMOTION)) &
+        (msg.moveType != static_cast<uint8_t>(ChessMove::MoveTypes::INVALID)) &
+        (msg.rightsToRevoke <= 0b1111) & //there are only 4 castle rights
+        (msg.wasCapture <= 1) &
+        (isPromotion == hasPromoType) //a promotion has to say what it promotes to, and nothing else can
+    ) != 0};
+
+    if( ! isValid )
+        return std::nullopt;
+
+    return PackedMove
+    {
+        ChessMove
+        {
+            {msg.fromFile, msg.fromRank},//source square
+            {msg.toFile, msg.toRank},//dest square
+            msg.wasCapture == 1,
+            static_cast<ChessMove::MoveTypes>(msg.moveType),
+            static_cast<unsigned char>(msg.rightsToRevoke),
+            static_cast<ChessMove::PromoTypes>(msg.promoType)
+        }
+    };
+}
+
+std::optional<Side> ProtocolCodec::toSide(PairingCompleteMsg const& msg)
+{
+    if(msg.side != static_cast<uint8_t>(Side::WHITE) && msg.side != static_cast<uint8_t>(Side::BLACK))
+        return std::nullopt;
+
+    return static_cast<Side>(msg.side);
+}
+
+auto ProtocolCodec::encodeMoveMessage(PackedMove const move) -> MoveMessage
+{
+    return encode(toMoveMsg(move));
+}
+
+std::optional<PackedMove> ProtocolCodec::decodeMoveMessage(std::span<std::byte const> const msg)
+{
+    return decode<MoveMsg>(msg).and_then(toPackedMove);
+}
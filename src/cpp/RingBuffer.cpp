@@ -0,0 +1,96 @@
+#include "RingBuffer.hpp"
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cstring>
+#include <utility>
+
+RingBuffer::RingBuffer(size_t const capacity)
+    : mStorage(std::bit_ceil(std::max<size_t>(capacity, 1))),
+      mScratch(mStorage.size())
+{
+}
+
+std::span<std::byte> RingBuffer::getWritableSpan()
+{
+    size_t const writeIdx {static_cast<size_t>(mWriteCursor) & getMask()};
+    size_t const untilEnd {getCapacity() - writeIdx};
+    return {mStorage.data() + writeIdx, std::min(untilEnd, getFreeSpace())};
+}
+
+void RingBuffer::commit(size_t const numBytes)
+{
+    assert(numBytes <= getFreeSpace());
+    mWriteCursor += numBytes;
+}
+
+bool RingBuffer::write(std::span<std::byte const> bytes)
+{
+    if(bytes.size() > getFreeSpace())
+        return false;
+
+    //at most two copies: up to the end of the storage, then from the start
+    while( ! bytes.empty() )
+    {
+        auto const writable {getWritableSpan()};
+        size_t const numBytes {std::min(writable.size(), bytes.size())};
+        std::memcpy(writable.data(), bytes.data(), numBytes);
+        commit(numBytes);
+        bytes = bytes.subspan(numBytes);
+    }
+
+    return true;
+}
+
+std::optional<std::byte> RingBuffer::peek(size_t const idx) const
+{
+    if(idx >= getSize())
+        return std::nullopt;
+
+    return mStorage[static_cast<size_t>(mReadCursor + idx) & getMask()];
+}
+
+std::optional<std::span<std::byte const>> RingBuffer::view(size_t const len)
+{
+    if(len > getSize())
+        return std::nullopt;
+
+    size_t const readIdx {static_cast<size_t>(mReadCursor) & getMask()};
+    size_t const untilEnd {getCapacity() - readIdx};
+    if(len <= untilEnd)
+        return std::span<std::byte const>{mStorage.data() + readIdx, len};
+
+    std::memcpy(mScratch.data(), mStorage.data() + readIdx, untilEnd);
+    std::memcpy(mScratch.data() + untilEnd, mStorage.data(), len - untilEnd);
+    return std::span<std::byte const>{mScratch.data(), len};
+}
+
+void RingBuffer::consume(size_t const len)
+{
+    assert(len <= getSize());
+    mReadCursor += len;
+
+    //starting again from the front once it is empty keeps the free space in one piece for getWritableSpan()
+    if(isEmpty())
+        clear();
+}
+
+void RingBuffer::reserve(size_t const capacity)
+{
+    if(capacity <= getCapacity())
+        return;
+
+    std::vector<std::byte> storage(std::bit_ceil(capacity));
+
+    //the bytes go to the front of the new storage, unwrapped
+    size_t const size {getSize()};
+    size_t const readIdx {static_cast<size_t>(mReadCursor) & getMask()};
+    size_t const untilEnd {std::min(size, getCapacity() - readIdx)};
+    std::memcpy(storage.data(), mStorage.data() + readIdx, untilEnd);
+    std::memcpy(storage.data() + untilEnd, mStorage.data(), size - untilEnd);
+
+    mStorage = std::move(storage);
+    mScratch.resize(mStorage.size());
+    mReadCursor = 0;
+    mWriteCursor = size;
+}
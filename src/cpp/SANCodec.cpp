@@ -0,0 +1,202 @@
+#include "SANCodec.hpp"
+#include "Board.hpp"
+#include "MoveList.hpp"
+
+static constexpr std::string_view PIECE_LETTERS {" PRNBQK"}; //indexed by PieceTypes
+
+static PieceTypes toPieceType(char const letter)
+{
+    auto const index {PIECE_LETTERS.find(letter)};
+    return index == std::string_view::npos || index == 0 ? PieceTypes::INVALID : static_cast<PieceTypes>(index);
+}
+
+static constexpr ChessMove::PromoTypes toPromoType(PieceTypes const type)
+{
+    switch(type)
+    {
+    case PieceTypes::QUEEN:  return ChessMove::PromoTypes::QUEEN;
+    case PieceTypes::ROOK:   return ChessMove::PromoTypes::ROOK;
+    case PieceTypes::KNIGHT: return ChessMove::PromoTypes::KNIGHT;
+    case PieceTypes::BISHOP: return ChessMove::PromoTypes::BISHOP;
+    default: return ChessMove::PromoTypes::INVALID;
+    }
+}
+
+static constexpr char toPromoLetter(ChessMove::PromoTypes const promoType)
+{
+    switch(promoType)
+    {
+    case ChessMove::PromoTypes::QUEEN:  return 'Q';
+    case ChessMove::PromoTypes::ROOK:   return 'R';
+    case ChessMove::PromoTypes::KNIGHT: return 'N';
+    case ChessMove::PromoTypes::BISHOP: return 'B';
+    default: return '?';
+    }
+}
+
+std::optional<PackedMove> SANCodec::parse(Board const& board, std::string_view san)
+{
+    while( ! san.empty() && std::string_view{"+#!?"}.find(san.back()) != std::string_view::npos )
+        san.remove_suffix(1);
+
+    MoveList legalMoves;
+    board.generateLegalMoves(legalMoves);
+
+    auto const& pos {board.getPosition()};
+
+    if(san == "O-O" || san == "0-0" || san == "O-O-O" || san == "0-0-0")
+    {
+        bool const isLong {san.size() == 5};
+        for(auto const move : legalMoves)
+        {
+            if(move.isCastle() && (move.getTo() < move.getFrom()) == isLong)
+                return move;
+        }
+        return std::nullopt;
+    }
+
+    //piece letter, disambiguation, optional x, destination, optional promotion
+    PieceTypes pieceType {PieceTypes::PAWN};
+    if( ! san.empty() && toPieceType(san.front()) != PieceTypes::INVALID )
+    {
+        pieceType = toPieceType(san.front());
+        san.remove_prefix(1);
+    }
+
+    ChessMove::PromoTypes promoType {ChessMove::PromoTypes::INVALID};
+    if( ! san.empty() && toPieceType(san.back()) != PieceTypes::INVALID)
+    {
+        promoType = toPromoType(toPieceType(san.back()));
+        if(promoType == ChessMove::PromoTypes::INVALID)
+            return std::nullopt;
+
+        san.remove_suffix(1);
+        if( ! san.empty() && san.back() == '=')
+            san.remove_suffix(1);
+    }
+
+    if(san.size() < 2)
+        return std::nullopt;
+
+    char const destFile {san[san.size() - 2]};
+    char const destRank {san[san.size() - 1]};
+    if(destFile < 'a' || destFile > 'h' || destRank < '1' || destRank > '8')
+        return std::nullopt;
+
+    Square const to {(destRank - '1') * 8 + (destFile - 'a')};
+    san.remove_suffix(2);
+
+    if( ! san.empty() && san.back() == 'x')
+        san.remove_suffix(1);
+
+    //whatever is left is the file and/or rank the piece moves from
+    int fromFile {-1};
+    int fromRank {-1};
+    for(char const c : san)
+    {
+        if(c >= 'a' && c <= 'h')      fromFile = c - 'a';
+        else if(c >= '1' && c <= '8') fromRank = c - '1';
+        else return std::nullopt;
+    }
+
+    std::optional<PackedMove> match;
+    for(auto const move : legalMoves)
+    {
+        Square const from {move.getFrom()};
+        if(move.getTo() != to || pos.pieceAt(from).getType() != pieceType || move.getPromoType() != promoType ||
+           (fromFile != -1 && from % 8 != fromFile) || (fromRank != -1 && from / 8 != fromRank))
+        {
+            continue;
+        }
+
+        if(match)
+            return std::nullopt; //ambiguous
+        match = move;
+    }
+
+    return match;
+}
+
+std::string_view SANCodec::write(Board& board, PackedMove const move, std::span<char, MAX_LENGTH> const out)
+{
+    size_t n {0};
+    auto const put = [&](char const c){ out[n++] = c; };
+    auto const putSquare = [&](Square const sq)
+    {
+        put(static_cast<char>('a' + sq % 8));
+        put(static_cast<char>('1' + sq / 8));
+    };
+
+    MoveList legalMoves;
+    board.generateLegalMoves(legalMoves);
+
+    Square const from {move.getFrom()};
+    Square const to {move.getTo()};
+    PieceTypes const pieceType {board.getPosition().pieceAt(from).getType()};
+
+    if(move.isCastle())
+    {
+        for(char const c : to < from ? std::string_view{"O-O-O"} : std::string_view{"O-O"})
+            put(c);
+    }
+    else if(pieceType == PieceTypes::PAWN)
+    {
+        if(move.isCapture())
+        {
+            put(static_cast<char>('a' + from % 8));
+            put('x');
+        }
+
+        putSquare(to);
+
+        if(move.isPromotion())
+        {
+            put('=');
+            put(toPromoLetter(move.getPromoType()));
+        }
+    }
+    else
+    {
+        put(PIECE_LETTERS[static_cast<size_t>(pieceType)]);
+
+        //the other pieces of the same type that can go to the same square decide how much of from is needed
+        bool isAmbiguous {false};
+        bool sharesFile {false};
+        bool sharesRank {false};
+        for(auto const other : legalMoves)
+        {
+            Square const otherFrom {other.getFrom()};
+            if(other.getTo() != to || otherFrom == from || board.getPosition().pieceAt(otherFrom).getType() != pieceType)
+                continue;
+
+            isAmbiguous = true;
+            sharesFile = sharesFile || otherFrom % 8 == from % 8;
+            sharesRank = sharesRank || otherFrom / 8 == from / 8;
+        }
+
+        if(isAmbiguous)
+        {
+            if( ! sharesFile )
+                put(static_cast<char>('a' + from % 8));
+            else if( ! sharesRank )
+                put(static_cast<char>('1' + from / 8));
+            else
+                putSquare(from);
+        }
+
+        if(move.isCapture())
+            put('x');
+
+        putSquare(to);
+    }
+
+    board.makeMove(move);
+    if(board.getCheckState() != Board::CheckType::NO_CHECK)
+    {
+        board.generateLegalMoves(legalMoves);
+        put(legalMoves.empty() ? '#' : '+');
+    }
+    board.unmakeMove();
+
+    return {out.data(), n};
+}
@@ -0,0 +1,403 @@
+#include "Search.hpp"
+#include "Evaluation.hpp"
+#include "MoveGen.hpp"
+#include <algorithm>
+#include <cassert>
+#include <cstdlib>
+
+//How many nodes are searched between looking at the clock and the stop token.
+static constexpr uint64_t STOP_CHECK_INTERVAL {2048};
+
+static constexpr int DRAW_SCORE {0};
+
+//Ordering scores. The transposition table move goes first, then captures and queen promotions,
+//then the killers, then the rest by their history.
+static constexpr int TT_MOVE_ORDER_SCORE       {1 << 30};
+static constexpr int CAPTURE_ORDER_SCORE       {1 << 29};
+static constexpr int FIRST_KILLER_ORDER_SCORE  {CAPTURE_ORDER_SCORE - 1};
+static constexpr int SECOND_KILLER_ORDER_SCORE {CAPTURE_ORDER_SCORE - 2};
+
+//The history scores are halved once any of them reaches this so they stay below the killers.
+static constexpr int MAX_HISTORY_SCORE {1 << 20};
+
+//Mate scores are stored relative to the position being stored rather than the root,
+//since the same position can be reached at a different ply later on.
+static int scoreToTranspositionTable(int const score, int const ply)
+{
+    if(score >= Search::MATE_BOUND) return score + ply;
+    if(score <= -Search::MATE_BOUND) return score - ply;
+    return score;
+}
+
+static int scoreFromTranspositionTable(int const score, int const ply)
+{
+    if(score >= Search::MATE_BOUND) return score - ply;
+    if(score <= -Search::MATE_BOUND) return score + ply;
+    return score;
+}
+
+Search::Search(TranspositionTable& transpositionTable, int const threadIndex)
+    : mTranspositionTable{transpositionTable},
+      mThreadIndex{threadIndex}
+{
+}
+
+void Search::setPosition(std::string_view const fen, std::span<PackedMove const> const moves)
+{
+    mBoard.setPosition(fen);
+
+    for(auto const& move : moves)
+        mBoard.makeMove(move);
+}
+
+SearchResult Search::run(SearchLimits const& limits, std::stop_token stopToken)
+{
+    mLimits = limits;
+    mStopToken = std::move(stopToken);
+    mStartTime = std::chrono::steady_clock::now();
+    mNodes = 0;
+    mTTProbes = 0;
+    mTTHits = 0;
+    mIsStopped = false;
+    mKillers = {};
+    mHistory = {};
+
+    SearchResult result {};
+
+    //the root moves are generated once here. Every iteration after the first searches them in the order the last one left them.
+    auto& rootMoves {mPlyMoves[0]};
+    mBoard.generateLegalMoves(rootMoves);
+
+    if(rootMoves.empty())
+    {
+        result.score = mBoard.getCheckState() == Board::CheckType::NO_CHECK ? DRAW_SCORE : -MATE_SCORE;
+        return result;
+    }
+
+    //a reply is better than no reply if the search gets stopped before depth 1 completes
+    result.bestMove = rootMoves.front();
+
+    //helpers start on a different root move
+    std::rotate(rootMoves.begin(), rootMoves.begin() + static_cast<std::ptrdiff_t>(mThreadIndex % rootMoves.size()), rootMoves.end());
+
+    int const maxDepth {std::min(mLimits.maxDepth, MAX_PLY - 1)};
+    for(int iteration = 1; iteration <= maxDepth; ++iteration)
+    {
+        //every other helper searches one ply deeper than the main thread
+        int const depth {std::min(iteration + (mThreadIndex & 1), maxDepth)};
+        if(depth == result.depth)
+            break;
+
+        int const score {searchRoot(depth)};
+
+        if(mIsStopped)
+            break;
+
+        result.bestMove = mRootBestMove;
+        result.score = score;
+        result.depth = depth;
+
+        if(mOnIterationComplete)
+        {
+            std::chrono::duration<double> const elapsed {std::chrono::steady_clock::now() - mStartTime};
+            result.nodes = mNodes;
+            result.ttProbes = mTTProbes;
+            result.ttHits = mTTHits;
+            result.seconds = elapsed.count();
+            mOnIterationComplete(result);
+        }
+
+        //no point looking any deeper once a forced mate has been found
+        if(std::abs(score) >= MATE_BOUND)
+            break;
+
+        //the next iteration would take longer than all of the ones before it, so dont start it
+        //if it is unlikely to finish in time
+        if(getElapsedTime() > mLimits.maxTime / 2)
+            break;
+    }
+
+    std::chrono::duration<double> const elapsed {std::chrono::steady_clock::now() - mStartTime};
+    result.nodes = mNodes;
+    result.ttProbes = mTTProbes;
+    result.ttHits = mTTHits;
+    result.seconds = elapsed.count();
+    return result;
+}
+
+int Search::searchRoot(int const depth)
+{
+    auto& rootMoves {mPlyMoves[0]};
+    int alpha {-INFINITE_SCORE};
+    PackedMove bestMove {};
+
+    //the best move from the last iteration is searched first (it is already at the front of rootMoves)
+    for(size_t i = 0; i < rootMoves.size(); ++i)
+    {
+        mBoard.makeMove(rootMoves[i]);
+        int const score {-negamax(depth - 1, -INFINITE_SCORE, -alpha, 1)};
+        mBoard.unmakeMove();
+
+        if(mIsStopped)
+            return 0;
+
+        if(score > alpha)
+        {
+            alpha = score;
+            bestMove = rootMoves[i];
+
+            //keep the best moves found so far at the front so the next iteration searches them first
+            std::rotate(rootMoves.begin(), rootMoves.begin() + static_cast<std::ptrdiff_t>(i),
+                rootMoves.begin() + static_cast<std::ptrdiff_t>(i) + 1);
+        }
+    }
+
+    mRootBestMove = bestMove;
+    return alpha;
+}
+
+int Search::negamax(int depth, int alpha, int const beta, int const ply)
+{
+    bool const isInCheck {mBoard.getCheckState() != Board::CheckType::NO_CHECK};
+
+    //look one move further when in check so the search doesn't stop in the middle of a forcing sequence
+    if(isInCheck)
+        ++depth;
+
+    if(depth <= 0)
+        return quiescence(alpha, beta, ply);
+
+    ++mNodes;
+    checkForStop();
+    if(mIsStopped)
+        return 0;
+
+    if(mBoard.getHalfmoveClock() >= 100 || mBoard.getRepetitionCount() >= 2)
+        return DRAW_SCORE;
+
+    if(ply >= MAX_PLY - 1)
+        return Evaluation::evaluate(mBoard.getPosition(), mBoard.getWhosTurnItIs());
+
+    using Bound = TranspositionTable::Bound;
+    auto const hash {mBoard.getHash()};
+    auto const maybeTTEntry {mTranspositionTable.probe(hash)};
+    auto const ttEntry {maybeTTEntry.value_or(TranspositionTable::Entry{})};
+    ++mTTProbes;
+    mTTHits += maybeTTEntry.has_value();
+
+    //a result from a search at least as deep can be used straight away if its bound says enough about this window
+    if(ttEntry.bound != Bound::NONE && ttEntry.depth >= depth)
+    {
+        int const ttScore {scoreFromTranspositionTable(ttEntry.score, ply)};
+
+        if(ttEntry.bound == Bound::EXACT ||
+          (ttEntry.bound == Bound::LOWER && ttScore >= beta) ||
+          (ttEntry.bound == Bound::UPPER && ttScore <= alpha))
+            return ttScore;
+    }
+
+    auto& moves {mPlyMoves[ply]};
+    mBoard.generateLegalMoves(moves);
+
+    if(moves.empty())
+        return isInCheck ? -MATE_SCORE + ply : DRAW_SCORE;
+
+    scoreMoves(ply, ttEntry);
+
+    int const originalAlpha {alpha};
+    int bestScore {-INFINITE_SCORE};
+    PackedMove bestMove {};
+
+    for(size_t i = 0; i < moves.size(); ++i)
+    {
+        auto const move {pickNextMove(ply, i)};
+        bool const isQuiet { ! move.isCapture() && ! move.isPromotion() };
+
+        mBoard.makeMove(move);
+        int const score {-negamax(depth - 1, -beta, -alpha, ply + 1)};
+        mBoard.unmakeMove();
+
+        if(mIsStopped)
+            return 0;
+
+        if(score > bestScore)
+        {
+            bestScore = score;
+            bestMove = move;
+        }
+
+        alpha = std::max(alpha, score);
+
+        if(alpha >= beta)
+        {
+            if(isQuiet)
+                onQuietMoveCutoff(move, depth, ply);
+            break;
+        }
+    }
+
+    mTranspositionTable.store(hash,
+    {
+        .move = bestMove,
+        .score = scoreToTranspositionTable(bestScore, ply),
+        .depth = depth,
+        .bound = bestScore >= beta ? Bound::LOWER : bestScore > originalAlpha ? Bound::EXACT : Bound::UPPER
+    });
+
+    return bestScore;
+}
+
+//Only captures (and every move when in check) are searched until the position is quiet,
+//so the evaluation isn't taken in the middle of an exchange.
+int Search::quiescence(int alpha, int const beta, int const ply)
+{
+    ++mNodes;
+    checkForStop();
+    if(mIsStopped)
+        return 0;
+
+    if(ply >= MAX_PLY - 1)
+        return Evaluation::evaluate(mBoard.getPosition(), mBoard.getWhosTurnItIs());
+
+    bool const isInCheck {mBoard.getCheckState() != Board::CheckType::NO_CHECK};
+
+    auto& moves {mPlyMoves[ply]};
+    moves.clear();
+
+    //the side to move can usually do at least as well as the static evaluation by making a quiet move (stand pat),
+    //except when in check where every move has to be looked at
+    if(isInCheck)
+    {
+        MoveGen::generate(mBoard, MoveGen::Stage::EVASIONS, moves);
+        if(moves.empty())
+            return -MATE_SCORE + ply;
+    }
+    else
+    {
+        int const standPat {Evaluation::evaluate(mBoard.getPosition(), mBoard.getWhosTurnItIs())};
+        if(standPat >= beta)
+            return standPat;
+
+        alpha = std::max(alpha, standPat);
+
+        //only the captures and promotions are generated, the quiet moves are never looked at here
+        MoveGen::generate(mBoard, MoveGen::Stage::CAPTURES, moves);
+        MoveGen::generate(mBoard, MoveGen::Stage::PROMOTIONS, moves);
+    }
+
+    scoreMoves(ply);
+
+    int bestScore {isInCheck ? -INFINITE_SCORE : alpha};
+    for(size_t i = 0; i < moves.size(); ++i)
+    {
+        auto const move {pickNextMove(ply, i)};
+
+        //underpromotions are left to the main search
+        if( ! isInCheck && move.isPromotion() && move.getPromoType() != ChessMove::PromoTypes::QUEEN)
+            continue;
+
+        mBoard.makeMove(move);
+        int const score {-quiescence(-beta, -alpha, ply + 1)};
+        mBoard.unmakeMove();
+
+        if(mIsStopped)
+            return 0;
+
+        bestScore = std::max(bestScore, score);
+        alpha = std::max(alpha, score);
+
+        if(alpha >= beta)
+            break;
+    }
+
+    return bestScore;
+}
+
+void Search::scoreMoves(int const ply, TranspositionTable::Entry const& ttEntry)
+{
+    auto const& moves {mPlyMoves[ply]};
+    auto& scores {mPlyMoveScores[ply]};
+    auto const& killers {mKillers[ply]};
+    auto const& history {mHistory[static_cast<size_t>(mBoard.getWhosTurnItIs())]};
+
+    for(size_t i = 0; i < moves.size(); ++i)
+    {
+        auto const move {moves[i]};
+        int score {0};
+
+        bool const isQueenPromotion {move.getPromoType() == ChessMove::PromoTypes::QUEEN};
+
+        if(move == ttEntry.move)
+            score = TT_MOVE_ORDER_SCORE;
+        else if(move.isCapture() || isQueenPromotion)
+        {
+            //MVV-LVA: the most valuable victim first, and the least valuable attacker first among captures of the same victim
+            auto const victim {move.isEnPassant() ? PieceTypes::PAWN : mBoard.getPosition().pieceAt(move.getTo()).getType()};
+            auto const attacker {mBoard.getPosition().pieceAt(move.getFrom()).getType()};
+
+            score = CAPTURE_ORDER_SCORE + Evaluation::getPieceValue(victim) * 16 - Evaluation::getPieceValue(attacker) / 16;
+
+            if(isQueenPromotion)
+                score += Evaluation::getPieceValue(PieceTypes::QUEEN) * 16;
+        }
+        else if(move == killers[0])
+            score = FIRST_KILLER_ORDER_SCORE;
+        else if(move == killers[1])
+            score = SECOND_KILLER_ORDER_SCORE;
+        else
+            score = history[move.getFrom()][move.getTo()];
+
+        scores[i] = score;
+    }
+}
+
+//Selection sort one move at a time. A cutoff usually happens within the first few moves,
+//so sorting the whole list up front would mostly be wasted work.
+PackedMove Search::pickNextMove(int const ply, size_t const index)
+{
+    auto& moves {mPlyMoves[ply]};
+    auto& scores {mPlyMoveScores[ply]};
+
+    auto const scoresEnd {scores.begin() + static_cast<std::ptrdiff_t>(moves.size())};
+    auto const best {std::max_element(scores.begin() + static_cast<std::ptrdiff_t>(index), scoresEnd)};
+    auto const bestIndex {static_cast<size_t>(best - scores.begin())};
+
+    std::swap(moves[index], moves[bestIndex]);
+    std::swap(scores[index], scores[bestIndex]);
+    return moves[index];
+}
+
+void Search::onQuietMoveCutoff(PackedMove const move, int const depth, int const ply)
+{
+    auto& killers {mKillers[ply]};
+    if(move != killers[0])
+    {
+        killers[1] = killers[0];
+        killers[0] = move;
+    }
+
+    auto& history {mHistory[static_cast<size_t>(mBoard.getWhosTurnItIs())]};
+    auto& score {history[move.getFrom()][move.getTo()]};
+    score += depth * depth;
+
+    if(score >= MAX_HISTORY_SCORE)
+    {
+        for(auto& fromSquare : history)
+            for(auto& toScore : fromSquare)
+                toScore /= 2;
+    }
+}
+
+void Search::checkForStop()
+{
+    if(mNodes % STOP_CHECK_INTERVAL != 0)
+        return;
+
+    mIsStopped = mStopToken.stop_requested() || mNodes >= mLimits.maxNodes || getElapsedTime() >= mLimits.maxTime;
+}
+
+//In milliseconds so comparing against SearchLimits::maxTime can't overflow when it is milliseconds::max().
+std::chrono::milliseconds Search::getElapsedTime() const
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - mStartTime);
+}
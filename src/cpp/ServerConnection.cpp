@@ -1,179 +1,184 @@
 #include "ServerConnection.hpp"
 #include "SettingsFileManager.hpp"
 #include "errorLogger.hpp"
-#include <ws2tcpip.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
 #include <cassert>
 #include <optional>
-#include <format>
 #include <future>
 #include <string>
 #include <array>
 #include <chrono>
 #include <utility>
 
-static void logLastError()
-{
-#ifdef _WIN32
-
-    int const ec {WSAGetLastError()};
-
-    //10054 = The connection was forcibly closed by the remote host.
-    if(ec == 10054)
-        return;
-
-    LPSTR msg {nullptr};
-    FormatMessageA
-    (
-        FORMAT_MESSAGE_ALLOCATE_BUFFER |
-        FORMAT_MESSAGE_FROM_SYSTEM     |
-        FORMAT_MESSAGE_IGNORE_INSERTS,
-        nullptr,
-        ec,
-        MAKELANGID(LANG_NEUTRAL, SUBLANG_DEFAULT),
-        reinterpret_cast<LPSTR>(&msg),
-        0,
-        nullptr
-    );
-
-    FileErrorLogger::get().log(msg);
-    LocalFree(msg);
-
-#else
-    char msg[strerrorlen_s(errno)]{};
-    strerror_s(msg, sizeof(msg), errno);
-    FileErrorLogger::get().log(msg);
-#endif
-}
-
 ServerConnection::ServerConnection(std::function<void()> onConnect, std::function<void()> onDisconnect)
     : mOnConnect{std::move(onConnect)}, mOnDisconnect{std::move(onDisconnect)}
 {
-    mReadBuff.resize(mReadBuffInitialSize);
-
-    if(int result {WSAStartup(MAKEWORD(2, 2), &mWinSockData)}; result == 0)
-        connectToServerAsync();
-    else
-        FileErrorLogger::get().log(std::format("WSAStartup() failed with error {}", result));
+    connectToServerAsync();
 }
 
-ServerConnection::~ServerConnection()
-{
-    closesocket(mSocket);
-    WSACleanup();
-}
+ServerConnection::~ServerConnection()=default;
 
 //Gets any new data that might have been sent from the server.
 void ServerConnection::update()
 {
-    if( ! mConnectToServerThreadIsDone ) [[unlikely]]
+    switch(mState)
+    {
+    case State::RESOLVING:
+    {
+        if(mFutureAddresses.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+        {
+            mAddresses = mFutureAddresses.get();
+            mNextAddress = 0;
+            connectToNextAddress();
+        }
+        break;
+    }
+    case State::CONNECTING:   updateConnecting();  break;
+    case State::CONNECTED:    receiveFromServer(); break;
+    case State::DISCONNECTED: break;
+    }
+}
+
+//Starts a non-blocking connect to the next address the server resolved to.
+void ServerConnection::connectToNextAddress()
+{
+    while(mNextAddress < mAddresses.size())
     {
-        auto const futureStatus { mFutureSocket.wait_for(std::chrono::microseconds(100)) };
-        if(futureStatus == std::future_status::ready)
+        auto sock {Socket::startConnect(mAddresses[mNextAddress++])};
+        if( ! sock )
         {
-            auto const maybeSocket {mFutureSocket.get()};
-            if(maybeSocket)
-            {
-                mSocket = *maybeSocket;
-                mIsConnected = true;
-                mOnConnect();
-            }
-            
-            mConnectToServerThreadIsDone = true;
+            FileErrorLogger::get().log(sock.error());
+            continue;
         }
 
+        mSocket = std::move(*sock);
+        mConnectStartTime = std::chrono::steady_clock::now();
+        mState = State::CONNECTING;
         return;
     }
 
-    if( ! mIsConnected ) { return; }
+    mState = State::DISCONNECTED;
+}
 
-    fd_set sockSet;
-    FD_ZERO(&sockSet);
-    FD_SET(mSocket, &sockSet);
-    timeval selectWaitTime{.tv_sec = 0, .tv_usec = 0};
+void ServerConnection::updateConnecting()
+{
+    auto const isConnected {mSocket.pollConnect()};
+    if( ! isConnected )
+    {
+        FileErrorLogger::get().log(isConnected.error());
+        mSocket.close();
+        connectToNextAddress();
+    }
+    else if(*isConnected)
+    {
+        mState = State::CONNECTED;
+        mOnConnect();
+    }
+    else if(std::chrono::steady_clock::now() - mConnectStartTime > s_connectTimeout)
+    {
+        FileErrorLogger::get().log("timed out connecting to the server");
+        mSocket.close();
+        connectToNextAddress();
+    }
+}
 
-    int selectResult {select(0, &sockSet, nullptr, nullptr, &selectWaitTime)};
-    
-    if(selectResult == SOCKET_ERROR)
+//Polls for readiness first so an idle frame costs one poll() instead of a failed recv().
+//Once readable, receives until the socket has nothing left (EWOULDBLOCK), so a burst of messages is
+//all read in the same frame instead of one buffer's worth per frame.
+void ServerConnection::receiveFromServer()
+{
+    auto const isReadable {mSocket.pollReadable()};
+    if( ! isReadable )
     {
-        logLastError();
         disconnect();
         return;
     }
-    else if(selectResult > 0)//select() has indicated that there is a message on the socket ready to be read.
-    {
-        int const recvResult { recv(mSocket, mReadBuff.data(), 
-            static_cast<int>(mReadBuff.size()), 0) };
 
-        if(recvResult == SOCKET_ERROR)
+    if( ! *isReadable )
+        return;
+
+    while(true)
+    {
+        if(mReadBuff.getFreeSpace() == 0)
         {
-            logLastError();
-            disconnect();
+            if(mReadBuff.getCapacity() >= s_readBuffMaxCapacity)
+                return;
+
+            mReadBuff.reserve(mReadBuff.getCapacity() * 2);
         }
-        else if(recvResult == 0)//The connection has been gracefully closed.
+
+        auto const received {mSocket.receive(mReadBuff.getWritableSpan())};
+        if( ! received )
         {
-            disconnect();
+            if(received.error() != Socket::Error::WOULD_BLOCK)
+                disconnect();
+
+            return;
         }
+
+        mReadBuff.commit(*received);
     }
 }
 
 std::optional<std::byte> ServerConnection::peek(uint32_t idx)
 {
-    if(idx >= mReadBuff.size())
-        return std::nullopt;
-
-    return static_cast<std::byte>(mReadBuff[idx]);
+    return mReadBuff.peek(idx);
 }
 
 //Call ServerConnection::update() first so that you have the most recent data from the socket.
-std::optional<std::vector<std::byte>> ServerConnection::read(std::size_t len)
+std::optional<std::span<std::byte const>> ServerConnection::read(std::size_t len)
 {
-    if(mReadBuff.size() < len)
-        return std::nullopt;
+    auto const bytes {mReadBuff.view(len)};
+    if(bytes)
+        mReadBuff.consume(len);
 
-    std::vector<std::byte> ret 
-    {
-        reinterpret_cast<std::byte*>(mReadBuff.data()), 
-        reinterpret_cast<std::byte*>(mReadBuff.data() + len)
-    };
-
-    mReadBuff.erase(mReadBuff.begin(), mReadBuff.begin() + len);
-
-    return std::make_optional(std::move(ret));
+    return bytes;
 }
 
-void ServerConnection::write(std::span<std::byte> buffer)
+void ServerConnection::write(std::span<std::byte const> buffer)
 {
-    int32_t numBytesSent {0}, numBytesToSend {static_cast<int32_t>(buffer.size())};
-    while(numBytesSent < buffer.size())
+    if(mState != State::CONNECTED)
+        return;
+
+    while( ! buffer.empty() )
     {
-        int res {send(mSocket, reinterpret_cast<char*>(buffer.data() + numBytesSent),
-            numBytesToSend, 0)};
+        auto const sent {mSocket.send(buffer)};
+        if(sent)
+        {
+            buffer = buffer.subspan(*sent);
+            continue;
+        }
 
-        if(res == SOCKET_ERROR)
+        //The socket is non-blocking, so wait a little for the send buffer to drain if it is full.
+        if(sent.error() == Socket::Error::WOULD_BLOCK)
         {
-            logLastError();
-            disconnect();
-            return;
+            auto const isWritable {mSocket.pollWritable(s_sendTimeoutMS)};
+            if(isWritable && *isWritable)
+                continue;
+
+            FileErrorLogger::get().log("timed out sending to the server");
         }
 
-        numBytesSent += res;
-        numBytesToSend -= res;
+        disconnect();
+        return;
     }
 }
 
 //arguments pass by value to avoid any potential race conditions
 //fname is the .txt file where the server address should be stored (ServerIP.txt)
-static std::optional<SOCKET> connectToServerImpl(std::filesystem::path fname, 
+static std::vector<Socket::Address> resolveServerAddress(std::filesystem::path fname,
     std::string defaultPort, std::string defaultIP);
 
 void ServerConnection::connectToServerAsync()
 {
-    if(mIsConnected) { return; }
+    if(mState != State::DISCONNECTED) { return; }
 
-    mFutureSocket = std::async
+    mState = State::RESOLVING;
+    mFutureAddresses = std::async
     (
         std::launch::async, 
-        connectToServerImpl, 
+        resolveServerAddress, 
         mServerAddrFileName, 
         mDefaultServerPortStr, 
         mDefaultServerIpStr
@@ -199,11 +204,13 @@ static bool verifyFilePort(std::string_view port)
     return true;
 }
 
+//inet_pton() returns 1 when the string is a valid address and 0 when it isn't
 static bool verifyFileIP(std::string_view ip)
 {
     char dummyBuffer[sizeof(in6_addr)] {};
-    return inet_pton(AF_INET,  ip.data(), dummyBuffer) == 0 ||
-           inet_pton(AF_INET6, ip.data(), dummyBuffer) == 0;
+    std::string const ipStr {ip};//inet_pton() needs the '\0'
+    return inet_pton(AF_INET,  ipStr.c_str(), dummyBuffer) == 1 ||
+           inet_pton(AF_INET6, ipStr.c_str(), dummyBuffer) == 1;
 }
 
 //Generates a new ServerIP.txt file. If ServerIP.txt already exists, it generate a new one.
@@ -264,8 +271,7 @@ static std::optional<std::string> getPortFromFile(std::filesystem::path const& f
     if(verifyFilePort(*maybeFilePort))
         return std::make_optional(std::move(*maybeFilePort));
 
-    auto const msg {std::format("The PORT value in {} is invalid", fname.string())};
-    FileErrorLogger::get().log(msg);
+    FileErrorLogger::get().log("The PORT value in ", fname.string(), " is invalid");
     return std::nullopt;
 }
 
@@ -284,74 +290,36 @@ static std::optional<std::string> getIPFromFile(std::filesystem::path const& fna
     if(verifyFileIP(*maybeFileIP))
         return std::make_optional(std::move(*maybeFileIP));
 
-    auto const msg {std::format("The IP value in {} is invalid", fname.string())};
-    FileErrorLogger::get().log(msg);
+    FileErrorLogger::get().log("The IP value in ", fname.string(), " is invalid");
     return std::nullopt;
 }
 
 //arguments pass by value to avoid any potential race conditions
 //fname is the .txt file where the server address should be stored (ServerIP.txt)
-static std::optional<SOCKET> connectToServerImpl(std::filesystem::path fname,
+static std::vector<Socket::Address> resolveServerAddress(std::filesystem::path fname,
     std::string defaultPort, std::string defaultIP)
 {
-    addrinfo hints
-    {
-        .ai_family   = AF_UNSPEC,
-        .ai_socktype = SOCK_STREAM,
-        .ai_protocol = IPPROTO_TCP
-    };
-
-    addrinfo* addrList {nullptr};
-
     //Try to get the ip and port from mServerAddrFileName settings .txt file.
     auto const maybeFilePort {getPortFromFile(fname, defaultPort, defaultIP)};
     auto const maybeFileIP   {getIPFromFile(fname, defaultPort, defaultIP)};
 
-    int getaddrinfoResult = getaddrinfo
-    (
-        maybeFileIP   ? maybeFileIP->c_str()   : defaultIP.data(),
-        maybeFilePort ? maybeFilePort->c_str() : defaultPort.data(),
-        &hints,
-        &addrList
-    );
-
-    if(getaddrinfoResult != 0)
+    auto addresses {Socket::resolve(maybeFileIP.value_or(defaultIP), maybeFilePort.value_or(defaultPort))};
+    if( ! addresses )
     {
-        logLastError();
-        return std::nullopt;
+        FileErrorLogger::get().log(addresses.error());
+        return {};
     }
 
-    SOCKET sock {INVALID_SOCKET};
-    for(auto list{addrList}; list; list = list->ai_next)
-    {
-        if((sock = socket(list->ai_family, list->ai_socktype, 0)) == INVALID_SOCKET)
-        {
-            logLastError();
-            continue;
-        }
-
-        if(connect(sock, list->ai_addr, static_cast<int>(list->ai_addrlen)) == SOCKET_ERROR)
-        {
-            logLastError();
-
-            if(closesocket(sock) == SOCKET_ERROR)
-                logLastError();
-
-            sock = INVALID_SOCKET;
-        }
-    }
-
-    freeaddrinfo(addrList);
-    
-    if(sock == INVALID_SOCKET)
-        return std::nullopt;
-
-    return sock;
+    return std::move(*addresses);
 }
 
 void ServerConnection::disconnect()
 {
+    if(mState != State::CONNECTED)
+        return;
+
     mOnDisconnect();
-    closesocket(mSocket);
-    mIsConnected = false;
-}
\ No newline at end of file
+    mSocket.close();
+    mReadBuff.clear();
+    mState = State::DISCONNECTED;
+}
@@ -3,6 +3,15 @@
 #include <algorithm>//std::for_each()
 #include <exception>
 #include <cassert>
+#include <cerrno>
+#include <vector>
+#include <system_error>
+
+//strerror_s is MSVC only (and strerror isn't thread safe), this works everywhere.
+static std::string getErrnoMessage()
+{
+    return std::generic_category().message(errno);
+}
 
 SettingsManager::SettingsManager(std::filesystem::path const& fileName)
     : mFileName{fileName}
@@ -65,12 +74,10 @@ auto SettingsManager::findKVPair(std::string_view key) const
 
     if(ifs.bad())
     {
-        char errMsg[1024]{};
-        strerror_s(errMsg, sizeof(errMsg), errno);
         return std::unexpected(Error
         {
             .code = Error::Code::FSTREAM_ERROR, 
-            .msg  = errMsg
+            .msg  = getErrnoMessage()
         });
     }
 
@@ -171,12 +178,10 @@ auto SettingsManager::checkStreamOpen(auto const& stream)
 {
     if( ! stream.is_open() )
     {
-        char errMsg[1024]{};
-        strerror_s(errMsg, sizeof(errMsg), errno);
         return Error
         {
             .code = Error::Code::FSTREAM_ERROR,
-            .msg = errMsg
+            .msg = getErrnoMessage()
         };
     }
 
@@ -0,0 +1,188 @@
+#include "Socket.hpp"
+#include "errorLogger.hpp"
+#include <cerrno>
+#include <cstring>
+#include <utility>
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <unistd.h>
+
+static std::string getErrorMessage(int const ec)
+{
+    return std::strerror(ec);
+}
+
+static bool isWouldBlock(int const ec)
+{
+    return ec == EAGAIN || ec == EWOULDBLOCK;
+}
+
+//ECONNRESET is just the server going away, which isn't worth logging.
+static Socket::Error toError(int const ec, char const* const what)
+{
+    if(isWouldBlock(ec))
+        return Socket::Error::WOULD_BLOCK;
+
+    if(ec == ECONNRESET || ec == EPIPE)
+        return Socket::Error::CLOSED;
+
+    FileErrorLogger::get().log(what, " failed: ", getErrorMessage(ec));
+    return Socket::Error::FAILED;
+}
+
+auto Socket::resolve(std::string const& host, std::string const& port)
+    -> std::expected<std::vector<Address>, std::string>
+{
+    //the order of addrinfo's members isn't the same on every platform, so they are set one at a time
+    addrinfo hints{};
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    hints.ai_protocol = IPPROTO_TCP;
+
+    addrinfo* addrList {nullptr};
+    if(int const result {getaddrinfo(host.c_str(), port.c_str(), &hints, &addrList)}; result != 0)
+        return std::unexpected{"could not resolve " + host + ":" + port + " (" + gai_strerror(result) + ")"};
+
+    std::vector<Address> addresses;
+    for(auto list {addrList}; list; list = list->ai_next)
+    {
+        if(list->ai_addrlen > sizeof(sockaddr_storage))
+            continue;
+
+        Address& address {addresses.emplace_back()};
+        std::memcpy(&address.storage, list->ai_addr, list->ai_addrlen);
+        address.length = list->ai_addrlen;
+        address.family = list->ai_family;
+    }
+
+    freeaddrinfo(addrList);
+    return addresses;
+}
+
+auto Socket::startConnect(Address const& address) -> std::expected<Socket, std::string>
+{
+    Socket sock {::socket(address.family, SOCK_STREAM, IPPROTO_TCP)};
+    if( ! sock.isOpen() )
+        return std::unexpected{"socket() failed: " + getErrorMessage(errno)};
+
+    int const flags {fcntl(sock.mFD, F_GETFL, 0)};
+    if(flags == -1 || fcntl(sock.mFD, F_SETFL, flags | O_NONBLOCK) == -1)
+        return std::unexpected{"could not make the socket non-blocking: " + getErrorMessage(errno)};
+
+    //the messages are a few bytes each, so don't hold them back waiting to fill a segment
+    int const noDelay {1};
+    if(setsockopt(sock.mFD, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay)) == -1)
+        FileErrorLogger::get().log("could not set TCP_NODELAY: ", getErrorMessage(errno));
+
+    if(::connect(sock.mFD, reinterpret_cast<sockaddr const*>(&address.storage), address.length) == -1 && errno != EINPROGRESS)
+        return std::unexpected{"connect() failed: " + getErrorMessage(errno)};
+
+    return sock;
+}
+
+std::expected<bool, std::string> Socket::pollConnect() const
+{
+    auto const isWritable {pollWritable()};
+    if( ! isWritable )
+        return std::unexpected{"poll() failed while connecting"};
+
+    if( ! *isWritable )
+        return false;
+
+    //the socket becomes writable when the connect is over, whether it worked or not
+    int ec {0};
+    socklen_t ecSize {sizeof(ec)};
+    if(getsockopt(mFD, SOL_SOCKET, SO_ERROR, &ec, &ecSize) == -1)
+        ec = errno;
+
+    if(ec != 0)
+        return std::unexpected{"connect() failed: " + getErrorMessage(ec)};
+
+    return true;
+}
+
+std::expected<bool, Socket::Error> Socket::poll(short const events, int const timeoutMS) const
+{
+    pollfd pfd {.fd = mFD, .events = events, .revents = 0};
+
+    int result {::poll(&pfd, 1, timeoutMS)};
+    while(result == -1 && errno == EINTR)
+        result = ::poll(&pfd, 1, timeoutMS);
+
+    if(result == -1)
+        return std::unexpected{toError(errno, "poll()")};
+
+    //POLLHUP/POLLERR count as ready, so the receive()/send() that follows finds out what happened
+    return result > 0 && (pfd.revents & (events | POLLHUP | POLLERR)) != 0;
+}
+
+std::expected<bool, Socket::Error> Socket::pollReadable(int const timeoutMS) const
+{
+    return poll(POLLIN, timeoutMS);
+}
+
+std::expected<bool, Socket::Error> Socket::pollWritable(int const timeoutMS) const
+{
+    return poll(POLLOUT, timeoutMS);
+}
+
+std::expected<size_t, Socket::Error> Socket::receive(std::span<std::byte> const buffer)
+{
+    ssize_t result {::recv(mFD, buffer.data(), buffer.size(), 0)};
+    while(result == -1 && errno == EINTR)
+        result = ::recv(mFD, buffer.data(), buffer.size(), 0);
+
+    if(result == -1)
+        return std::unexpected{toError(errno, "recv()")};
+
+    if(result == 0)//The connection has been gracefully closed.
+        return std::unexpected{Error::CLOSED};
+
+    return static_cast<size_t>(result);
+}
+
+std::expected<size_t, Socket::Error> Socket::send(std::span<std::byte const> const buffer)
+{
+    //MSG_NOSIGNAL so a closed connection is an EPIPE error instead of a SIGPIPE that ends the program
+    ssize_t result {::send(mFD, buffer.data(), buffer.size(), MSG_NOSIGNAL)};
+    while(result == -1 && errno == EINTR)
+        result = ::send(mFD, buffer.data(), buffer.size(), MSG_NOSIGNAL);
+
+    if(result == -1)
+        return std::unexpected{toError(errno, "send()")};
+
+    if(result == 0)
+        return std::unexpected{Error::WOULD_BLOCK};
+
+    return static_cast<size_t>(result);
+}
+
+void Socket::close()
+{
+    if(mFD != INVALID_FD)
+        ::close(std::exchange(mFD, INVALID_FD));
+}
+
+Socket::Socket(Socket&& other) noexcept
+    : mFD{std::exchange(other.mFD, INVALID_FD)}
+{
+}
+
+Socket& Socket::operator=(Socket&& other) noexcept
+{
+    if(this != &other)
+    {
+        close();
+        mFD = std::exchange(other.mFD, INVALID_FD);
+    }
+
+    return *this;
+}
+
+Socket::~Socket()
+{
+    close();
+}
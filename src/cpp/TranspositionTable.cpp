@@ -0,0 +1,140 @@
+#include "TranspositionTable.hpp"
+#include "Bitboard.hpp"
+#include <algorithm>
+#include <bit>
+#include <limits>
+
+TranspositionTable::TranspositionTable(size_t const sizeInMB)
+{
+    resize(sizeInMB);
+}
+
+void TranspositionTable::resize(size_t const sizeInMB)
+{
+    size_t const numBuckets {std::max<size_t>(sizeInMB * 1024 * 1024 / sizeof(Bucket), 1)};
+    mNumBuckets = std::bit_floor(numBuckets);
+    mBuckets = std::make_unique<Bucket[]>(mNumBuckets);
+    mAge = 0;
+}
+
+void TranspositionTable::clear()
+{
+    for(size_t i = 0; i < mNumBuckets; ++i)
+    {
+        for(auto& slot : mBuckets[i].slots)
+        {
+            slot.hashXorData.store(0, std::memory_order_relaxed);
+            slot.data.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    mAge = 0;
+}
+
+std::optional<TranspositionTable::Entry> TranspositionTable::probe(uint64_t const hash) const
+{
+    for(auto const& slot : getBucket(hash).slots)
+    {
+        uint64_t const data {slot.data.load(std::memory_order_relaxed)};
+        uint64_t const slotHash {slot.hashXorData.load(std::memory_order_relaxed) ^ data};
+
+        if(slotHash == hash && getBound(data) != Bound::NONE)
+            return unpack(data);
+    }
+
+    return std::nullopt;
+}
+
+void TranspositionTable::store(uint64_t const hash, Entry const& entry)
+{
+    auto& bucket {getBucket(hash)};
+
+    //Use the slot already holding this position, otherwise an empty slot, otherwise the slot least worth keeping.
+    //Deep entries are worth the most since they took the longest to search, but entries from older searches
+    //lose out since those positions are less and less likely to come up again.
+    Bucket::Slot* replace {nullptr};
+    uint64_t replaceData {0};
+    int lowestWorth {std::numeric_limits<int>::max()};
+
+    for(auto& slot : bucket.slots)
+    {
+        uint64_t const data {slot.data.load(std::memory_order_relaxed)};
+        uint64_t const slotHash {slot.hashXorData.load(std::memory_order_relaxed) ^ data};
+
+        if(slotHash == hash || getBound(data) == Bound::NONE)
+        {
+            replace = &slot;
+            replaceData = data;
+            break;
+        }
+
+        int const age {static_cast<uint8_t>(mAge - getAge(data))};
+        int const worth {getDepth(data) - 8 * age};
+        if(worth < lowestWorth)
+        {
+            lowestWorth = worth;
+            replace = &slot;
+            replaceData = data;
+        }
+    }
+
+    Entry toStore {entry};
+
+    bool const isSamePosition {(replace->hashXorData.load(std::memory_order_relaxed) ^ replaceData) == hash &&
+        getBound(replaceData) != Bound::NONE};
+
+    if(isSamePosition)
+    {
+        //A much shallower result isn't worth overwriting a deeper one from this search with (unless it is exact).
+        if(entry.bound != Bound::EXACT && getAge(replaceData) == mAge && entry.depth + 3 < getDepth(replaceData))
+            return;
+
+        //keep the old move rather than storing none
+        if( ! entry.move )
+            toStore.move = unpack(replaceData).move;
+    }
+
+    uint64_t const data {pack(toStore)};
+    replace->hashXorData.store(hash ^ data, std::memory_order_relaxed);
+    replace->data.store(data, std::memory_order_relaxed);
+}
+
+uint64_t TranspositionTable::pack(Entry const& entry) const
+{
+    uint64_t data {entry.move.getBits()};
+
+    data |= static_cast<uint64_t>(static_cast<uint16_t>(entry.score)) << 16;
+    data |= static_cast<uint64_t>(std::clamp(entry.depth, 0, 255)) << 32;
+    data |= static_cast<uint64_t>(entry.bound) << 40;
+    data |= static_cast<uint64_t>(mAge) << 42;
+    return data;
+}
+
+TranspositionTable::Entry TranspositionTable::unpack(uint64_t const data)
+{
+    Entry entry {};
+    entry.move = PackedMove::fromBits(static_cast<uint16_t>(data));
+
+    entry.score = static_cast<int16_t>(static_cast<uint16_t>(data >> 16));
+    entry.depth = getDepth(data);
+    entry.bound = getBound(data);
+    return entry;
+}
+
+int TranspositionTable::getPermillFull() const
+{
+    size_t const numSampled {std::min<size_t>(mNumBuckets, 1000)};
+    size_t numUsed {0};
+
+    for(size_t i = 0; i < numSampled; ++i)
+    {
+        for(auto const& slot : mBuckets[i].slots)
+        {
+            uint64_t const data {slot.data.load(std::memory_order_relaxed)};
+            if(getBound(data) != Bound::NONE && getAge(data) == mAge)
+                ++numUsed;
+        }
+    }
+
+    return static_cast<int>(numUsed * 1000 / (numSampled * 4));
+}
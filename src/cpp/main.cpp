@@ -7,6 +7,8 @@
 #include "Board.hpp"
 #include "ChessRenderer.hpp"
 #include "ConnectionManager.hpp"
+#include "Engine.hpp"
+#include "GameRecorder.hpp"
 #include "SoundManager.hpp"
 
 static void runApplication();
@@ -33,7 +35,7 @@ int main(int argumentCount, char** argumentVector)
     return EXIT_SUCCESS;
 }
 
-void handleLeftClickPressSDLEvent(Board&, ConnectionManager const&, 
+void handleLeftClickPressSDLEvent(Board&, ConnectionManager const&, Engine const&,
     AppEventSystem::Publisher const& appEventPublisher);
 
 void handleLeftClickReleaseSDLEvent(Board&, ChessRenderer const&, 
@@ -45,6 +47,7 @@ static void runApplication()
     GUIEventSystem guiEventSys;
     BoardEventSystem boardEventSys;
     AppEventSystem appEventSys;
+    EngineEventSystem engineEventSys;
 
     ConnectionManager connectionManager {networkEventSys.getPublisher(), guiEventSys.getSubscriber(), 
         boardEventSys.getSubscriber()};
@@ -55,7 +58,12 @@ static void runApplication()
     SoundManager soundManager {boardEventSys.getSubscriber()};
 
     Board board {boardEventSys.getPublisher(), guiEventSys.getSubscriber(), 
-        networkEventSys.getSubscriber(), appEventSys.getSubscriber()};
+        networkEventSys.getSubscriber(), appEventSys.getSubscriber(), engineEventSys.getSubscriber()};
+
+    Engine engine {board, engineEventSys.getPublisher(), guiEventSys.getSubscriber(), 
+        networkEventSys.getSubscriber()};
+
+    GameRecorder gameRecorder {board, boardEventSys.getSubscriber()};
 
     bool appRunning {true};
 
@@ -69,6 +77,7 @@ static void runApplication()
         //auto const start {std::chrono::steady_clock::now()};
 
         connectionManager.update();
+        engine.update();
 
         SDL_Event evnt;
         while(SDL_PollEvent(&evnt))
@@ -85,7 +94,7 @@ static void runApplication()
             case SDL_MOUSEBUTTONDOWN: 
             {
                 if(evnt.button.button == SDL_BUTTON_LEFT)
-                    handleLeftClickPressSDLEvent(board, connectionManager, appEventSys.getPublisher());
+                    handleLeftClickPressSDLEvent(board, connectionManager, engine, appEventSys.getPublisher());
 
                 break;
             }
@@ -119,10 +128,10 @@ static void handleLeftClickReleaseSDLEvent(Board& board, ChessRenderer const& ch
 }
 
 static void handleLeftClickPressSDLEvent(Board& board, ConnectionManager const& connectionManager, 
-    AppEventSystem::Publisher const& appEventPublisher)
+    Engine const& engine, AppEventSystem::Publisher const& appEventPublisher)
 {
-    //if we are playing online and it is not our turn
-    if(connectionManager.isPairedOnline() && board.getSideUserIsPlayingAs() != board.getWhosTurnItIs())
+    //if we are playing online or against the computer and it is not our turn
+    if((connectionManager.isPairedOnline() || engine.isPlaying()) && board.getSideUserIsPlayingAs() != board.getWhosTurnItIs())
         return;
 
     int x{0}, y{0};
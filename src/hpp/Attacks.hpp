@@ -0,0 +1,77 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include "Bitboard.hpp"
+#include "chessNetworkProtocol.h" //enum Side
+
+#if defined(__BMI2__)
+#include <immintrin.h> //_pext_u64
+#define CHESS_USE_PEXT
+#endif
+
+//Precomputed attack tables. Looking up the squares a knight, king or pawn attacks is a single table read.
+//For the sliding pieces, looking up the squares a rook/bishop/queen attacks
+//is a mask, a multiply and a shift into a table (or a single pext instruction when BMI2 is available)
+//instead of stepping along each ray one square at a time. The tables are filled in
+//during static initialization (see Attacks.cpp), so they are ready before main() runs.
+class Attacks
+{
+public:
+
+    //The squares attacked by a rook/bishop/queen on sq given every occupied square on the board.
+    //The first blocker in each direction is included in the attacks, whichever side it belongs to.
+    static Bitboard getRookAttacks(Square sq, Bitboard occupied)   {return s_rookMagics[sq].lookup(occupied);}
+    static Bitboard getBishopAttacks(Square sq, Bitboard occupied) {return s_bishopMagics[sq].lookup(occupied);}
+    static Bitboard getQueenAttacks(Square sq, Bitboard occupied)
+    {
+        return getRookAttacks(sq, occupied) | getBishopAttacks(sq, occupied);
+    }
+
+    //The squares a knight/king on sq attacks, and the (at most two) squares a pawn of side on sq attacks.
+    static Bitboard getKnightAttacks(Square sq) {return s_knightAttacks[sq];}
+    static Bitboard getKingAttacks(Square sq)   {return s_kingAttacks[sq];}
+    static Bitboard getPawnAttacks(Side side, Square sq) {return s_pawnAttacks[side == Side::WHITE ? 0 : 1][sq];}
+
+    //The squares strictly in between a and b, and the whole line (edge to edge) going through both of them.
+    //Both are empty if a and b aren't on the same rank, file or diagonal.
+    static Bitboard getSquaresBetween(Square a, Square b) {return s_between[a][b];}
+    static Bitboard getLine(Square a, Square b) {return s_line[a][b];}
+
+private:
+
+    struct Magic
+    {
+        Bitboard mask  {0}; //the squares that can block the slider (board edges excluded)
+        Bitboard magic {0}; //unused when CHESS_USE_PEXT is defined
+        Bitboard const* attacks {nullptr}; //this square's slice of the shared attack table
+        unsigned shift {0};
+
+        unsigned index(Bitboard const occupied) const
+        {
+#ifdef CHESS_USE_PEXT
+            return static_cast<unsigned>(_pext_u64(occupied, mask));
+#else
+            return static_cast<unsigned>(((occupied & mask) * magic) >> shift);
+#endif
+        }
+
+        Bitboard lookup(Bitboard const occupied) const {return attacks[index(occupied)];}
+    };
+
+    //The sum over all squares of 2^(number of relevant blockers).
+    static constexpr size_t s_rookTableSize   {102400};
+    static constexpr size_t s_bishopTableSize {5248};
+
+    static std::array<Magic, 64> s_rookMagics;
+    static std::array<Magic, 64> s_bishopMagics;
+    static std::array<Bitboard, s_rookTableSize>   s_rookTable;
+    static std::array<Bitboard, s_bishopTableSize> s_bishopTable;
+
+    static std::array<Bitboard, 64> s_knightAttacks;
+    static std::array<Bitboard, 64> s_kingAttacks;
+    static std::array<std::array<Bitboard, 64>, 2> s_pawnAttacks; //[0] is white and [1] is black
+    static std::array<std::array<Bitboard, 64>, 64> s_between;
+    static std::array<std::array<Bitboard, 64>, 64> s_line;
+
+    friend struct AttackTablesInitializer;
+};
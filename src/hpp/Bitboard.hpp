@@ -0,0 +1,57 @@
+#pragma once
+#include <cstdint>
+#include <bit>
+#include "Vector2i.hpp"
+
+//A set of squares with one bit per square. Bit 0 is a1, bit 7 is h1 and bit 63 is h8,
+//which is the same rank * 8 + file layout the Board uses to index its array of pieces.
+using Bitboard = uint64_t;
+
+//A square index (0-63) in the same layout as the bits of a Bitboard.
+using Square = int;
+
+inline constexpr Square INVALID_SQUARE {-1};
+
+inline constexpr Bitboard FILE_A_BB {0x0101010101010101ull};
+inline constexpr Bitboard FILE_H_BB {FILE_A_BB << 7};
+inline constexpr Bitboard RANK_1_BB {0xFFull};
+inline constexpr Bitboard RANK_8_BB {RANK_1_BB << 56};
+
+constexpr Square toSquare(Vec2i const chessPos)
+{
+    return chessPos.y * 8 + chessPos.x;
+}
+
+constexpr Vec2i toChessPos(Square const sq)
+{
+    return {sq % 8, sq / 8};
+}
+
+constexpr Bitboard squareBB(Square const sq)
+{
+    return Bitboard{1} << sq;
+}
+
+constexpr bool testSquare(Bitboard const bb, Square const sq)
+{
+    return (bb & squareBB(sq)) != 0;
+}
+
+constexpr int popCount(Bitboard const bb)
+{
+    return std::popcount(bb);
+}
+
+//The least significant set square. bb must not be empty.
+constexpr Square lsb(Bitboard const bb)
+{
+    return std::countr_zero(bb);
+}
+
+//Removes the least significant set square from bb and returns it. bb must not be empty.
+constexpr Square popLsb(Bitboard& bb)
+{
+    Square const sq {lsb(bb)};
+    bb &= bb - 1;
+    return sq;
+}
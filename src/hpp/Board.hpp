@@ -1,18 +1,21 @@
 #pragma once
-#include "SDL.h"
-
 #include <string>
 #include <array>
 #include <vector>
 #include <memory> //std::shared_ptr
 #include <optional>
+#include <expected>
 #include <unordered_map>
+#include <ranges>
 
 #include "Vector2i.hpp"
 #include "chessNetworkProtocol.h" //enum Side
 #include "ChessEvents.hpp"
 #include "ChessMove.hpp"
 #include "castleRights.hpp"
+#include "Position.hpp"
+#include "FENCodec.hpp"
+#include "MoveList.hpp"
 
 class Piece;
 class ConnectionManager;
@@ -23,7 +26,8 @@ class Board
 public:
 
     Board(BoardEventSystem::Publisher const&, GUIEventSystem::Subscriber&, 
-        NetworkEventSystem::Subscriber&, AppEventSystem::Subscriber& appEventSubscriber);
+        NetworkEventSystem::Subscriber&, AppEventSystem::Subscriber& appEventSubscriber,
+        EngineEventSystem::Subscriber&);
 
     //factory method for placing a piece at the specified location on the board
     //these should only be called in the boards constructor ideally to follow RAII.
@@ -32,11 +36,57 @@ public:
     template<typename ConcreteTy> 
     void makeNewPieceAt(Vec2i const& pos, Side side);
 
-    void pickUpPiece(Vec2i chessPos) const;
+    void pickUpPiece(Vec2i chessPos);
     void putPieceDown(Vec2i chessPos);
 
+    //The piece the user is holding with the mouse, nullptr if none. Part of each Board rather than
+    //a global so any number of Boards (search threads, validators) can exist at once.
+    std::shared_ptr<Piece> const& getPieceOnMouse() const {return mPieceOnMouse;}
+
     void resetBoard();
 
+    //Clears the board and sets it up from a FEN string (see FENCodec::parse()). If fen can't be parsed
+    //the error is logged and returned, and the board is left as it was.
+    std::expected<void, FENError> setPosition(std::string_view fen);
+
+    //The same as above for a fen that has already been parsed into position, so it isn't parsed a second time.
+    void setPosition(std::string_view fen, FENPosition const& position);
+
+    //The current position (and the FEN string of it) as FENCodec sees it.
+    FENPosition getFENPosition() const;
+    std::string getFEN() const;
+
+    //Plays move on the board without publishing any events. move must be one of the legal moves for the side to move
+    //(see generateLegalMoves()). The check state is kept up to date but the legal moves aren't generated,
+    //so getLegalMoves() is left describing the position before the move until updateLegalMoves() is called.
+    //Each makeMove() is taken back by an unmakeMove() in the reverse order.
+    void makeMove(PackedMove move);
+
+    //Takes back the last move played by makeMove(). The pieces, castle rights, en passant square,
+    //check state and whose turn it is are restored from the undo record.
+    void unmakeMove();
+
+    //Every legal move for the side to move, with each promotion listed once per piece it can promote to.
+    //out is cleared first. Generated on the spot (see MoveGen.hpp) so it never allocates.
+    void generateLegalMoves(MoveList& out) const;
+
+    //The legal moves for the side to move kept for the user and the GUI. Updated by updateLegalMoves(),
+    //which setPosition() and commitMove() call (makeMove() doesn't, since the search has no use for them).
+    MoveList const& getLegalMoves() const {return mLegalMoves;}
+    void updateLegalMoves();
+
+    //True if move is one of getLegalMoves() (flags included). A couple of table lookups rather than
+    //a search through the moves, so every move coming in over the network can be checked for free.
+    bool isLegalMove(PackedMove move) const;
+
+    //The FEN given to the last setPosition() and the moves played since then (oldest first),
+    //which together are enough to set up another Board with the same position and history.
+    std::string const& getStartingFEN() const {return mStartingFEN;}
+    auto getMoveHistory() const {return mUndoStack | std::views::transform(&UndoRecord::move);}
+
+    //True if the side to move is checkmated or stalemated or the game has been drawn by rule.
+    bool isGameOver() const {return hasCheckOrStalemateOccurred() || hasDrawByRuleOccurred();}
+
     static bool isValidChessPosition(Vec2i);
 
     bool hasCastleRights(CastleRights::Rights) const;
@@ -44,27 +94,45 @@ public:
     //supply with one of the enums above and will respond with true or false
     std::shared_ptr<Piece> getPieceAt(Vec2i const& chessPos) const&;
 
+    //Cheaper than getPieceAt() since it reads the mailbox instead of copying a shared_ptr.
+    //Use this when only the type/side of what is on a square is needed (move generation).
+    PieceCode getPieceCodeAt(Vec2i const& chessPos) const {return mPosition.pieceAt(chessPos);}
+    Position const& getPosition() const {return mPosition;}
+
     Side getWhosTurnItIs() const {return mWhiteOrBlacksTurn;}
-    std::vector<Vec2i> getAttackedSquares(Side) const; //Get all the squares that are under attack for a given side.
-    
-    void setLastCapturedPiece(auto p) {m_lastCapturedPiece = p;}
+
+    //The Zobrist hash of the position (the pieces, whose turn it is, the castle rights and the en passant file if
+    //an en passant capture can actually be made).
+    //mPosition keeps the pieces part of it up to date as pieces are put down, captured and moved, so this is O(1).
+    uint64_t getHash() const;
+
+    //Half moves since the last capture or pawn move, and the move number which goes up after black moves (both as in a FEN string).
+    int getHalfmoveClock() const {return mHalfmoveClock;}
+    int getFullmoveNumber() const {return mFullmoveNumber;}
+
+    //How many times the current position has occurred in this game, counting the current occurrence.
+    //Only the positions since the last capture or pawn move are looked at since none before it can repeat.
+    int getRepetitionCount() const;
+
     void setSideUserIsPlayingAs(Side s) {m_sideUserIsPlayingAs = s;}
     auto getSideUserIsPlayingAs() const {return m_sideUserIsPlayingAs;}
     auto const& getPieces() const {return m_pieces;}
 
     enum struct CheckType{INVALID = -1, NO_CHECK, SINGLE_CHECK, DOUBLE_CHECK};
-    CheckType getCheckState() const {return mCurrentCheckType;}
-    Vec2i getLocationOfCheckingPiece() const {return mCheckingPieceLocation;} //Get the chess position of the piece which is putting a king in check.
+    CheckType getCheckState() const;
+    Vec2i getLocationOfCheckingPiece() const; //Get the chess position of the piece which is putting a king in check.
+
+    //The enemy pieces giving check to the side to move and the side to move's pieces pinned to their king.
+    //Both are worked out once per position by updateCheckState() so move generation only has to AND with them.
+    Bitboard getCheckers() const {return mCheckers;}
+    Bitboard getPinnedPieces() const {return mPinned;}
 
     void updateEnPassant(Vec2i newPostition);
     auto isEnPassantAvailable() const {return mEnPassantLocation != INVALID_VEC2I;}
     auto getEnPassantLocation() const {return mEnPassantLocation;}
     void resetEnPassant() {mEnPassantLocation = INVALID_VEC2I;}
 
-    void updateLegalMoves();//updates the pieces internal psuedo legal, fully legal, and attacked squares vectors
-    void updatePinnedPieces();
-    void updatePseudoLegalsAndAttackedSquares();//update the pieces _PseudoLegals and get a vector of all attacked squares for the side that just made a move
-    void updateCheckState();//update m_checkState
+    void updateCheckState();//update mCheckers and mPinned for the side to move
 
     void toggleTurn();//change who's turn it is to move 
 
@@ -79,8 +147,11 @@ private:
         PROMOTION_END,
         PAIRING_COMPLETE,
         OPPONENT_MADE_MOVE,
+        OPPONENT_SENT_MALFORMED_MOVE,
         UNPAIRED,
-        REMATCH_ACCEPT
+        REMATCH_ACCEPT,
+        PLAY_AGAINST_ENGINE,
+        BEST_MOVE_FOUND
     };
 
     SubscriptionManager<SubscriptionTypes,
@@ -89,15 +160,29 @@ private:
     SubscriptionManager<SubscriptionTypes,
         NetworkEventSystem::Subscriber> mNetworkSubManager;
 
+    SubscriptionManager<SubscriptionTypes,
+        EngineEventSystem::Subscriber> mEngineSubManager;
+
     AppEventSystem::Subscriber& mAppEventSubscriber;
     SubscriptionID mLeftClickReleaseSubID {INVALID_SUBSCRIPTION_ID};
 
     std::array<std::shared_ptr<Piece>, 64> m_pieces {};
-    std::shared_ptr<Piece> m_lastCapturedPiece {nullptr};
+    std::shared_ptr<Piece> mPieceOnMouse {nullptr}; //see getPieceOnMouse()
+
+    //The bitboard/mailbox view of m_pieces. Kept in sync by makeNewPieceAt(), movePiece() and capturePiece().
+    Position mPosition;
+
+    //See getLegalMoves().
+    MoveList mLegalMoves;
+
+    //mLegalMoves as lookup tables for isLegalMove(). The squares the piece on each square can move to,
+    //and the flags of the move from/to (without the promotion piece, any of them is fine). An entry of
+    //mLegalMoveFlags is only meaningful if its destination is in mLegalDestinations, so it is never cleared.
+    std::array<Bitboard, 64> mLegalDestinations {};
+    std::array<std::array<uint8_t, 64>, 64> mLegalMoveFlags {};
 
-    CheckType mCurrentCheckType {CheckType::INVALID}; //If there is no check currently, this will be set to NO_CHECK
-    Vec2i     mCheckingPieceLocation {INVALID_VEC2I}; //where is the piece putting a king in check otherwise INVALID_CHESS_SQUARE
-    Vec2i     m_locationOfSecondCheckingPiece {INVALID_VEC2I}; //if the check state is in double check where is the second piece putting the king in check
+    Bitboard mCheckers {0}; //the enemy pieces attacking the side to move's king
+    Bitboard mPinned {0};   //the side to move's pieces that can only move along the line between their king and the pinner
 
     Side mWhiteOrBlacksTurn {Side::WHITE};
     Side m_sideUserIsPlayingAs {Side::INVALID}; //only used when playing against an opponent online
@@ -108,31 +193,73 @@ private:
     //INVALID_CHESS_SQUARE if there is no en passant available.
     Vec2i mEnPassantLocation {INVALID_VEC2I};
 
-    ChessMove mLastMoveMade;
+    std::string mStartingFEN;
 
-    //methods called inside of postMoveUpdate() for handling certain special move types
-    void handleDoublePushMove();
-    void handleCastleMove();
-    void handleEnPassantMove();
+    int mHalfmoveClock {0};
+    int mFullmoveNumber {1};
+
+    //getHash() of every position in the game so far, the current position being last.
+    //Pushed by makeMove() and popped by unmakeMove(). Capacity is reserved up front like mUndoStack.
+    std::vector<uint64_t> mHashHistory;
+
+    //Everything makeMove() changes that can't be worked out again from the move itself.
+    //Moving the shared_ptrs in and out of here doesn't touch their ref counts.
+    struct UndoRecord
+    {
+        PackedMove move;
+        std::shared_ptr<Piece> capturedPiece {nullptr}; //nullptr if the move wasn't a capture
+        std::shared_ptr<Piece> promotedPawn  {nullptr}; //the pawn that was replaced if the move was a promotion
+        CastleRights castlingRights;
+        Vec2i enPassantLocation {INVALID_VEC2I};
+        Bitboard checkers {0};
+        Bitboard pinned {0};
+        int halfmoveClock {0};
+    };
 
-    void postMoveUpdate();
-    void movePiece(ChessMove const& move);
+    //The pieces makeMove() promotes pawns to, so that playing a promotion doesn't allocate. Indexed by [Side][PieceTypes]
+    //like Position. A side has at most 8 pawns, so 8 of each piece is enough for any line played from the position
+    //setPosition() set up (which fills them up again). unmakeMove() puts the piece back.
+    static constexpr size_t NUM_SPARE_PROMOTION_PIECES {8};
+    std::array<std::array<std::vector<std::shared_ptr<Piece>>, 7>, 3> mSparePromotionPieces {};
+
+    template<typename ConcreteTy>
+    void fillSparePromotionPieces(Side side);
+
+    //One record per makeMove() that hasn't been taken back yet.
+    //Capacity is reserved up front so playing moves doesn't allocate.
+    std::vector<UndoRecord> mUndoStack;
+
+    //A promotion the user has made on the board but hasn't picked a piece for yet (waiting on GUIEvents::PromotionEnd).
+    std::optional<ChessMove> mPendingPromotion {std::nullopt};
+
+    //Plays move with makeMove() then lets the rest of the app know about it
+    //(BoardEvents::MoveCompleted and BoardEvents::GameOver).
+    //All moves made by the user or the opponent go through this method.
+    void commitMove(ChessMove move);
+
+    //Checks a move from NetworkEvents::OpponentMadeMove with isLegalMove() before committing it.
+    //Publishes BoardEvents::ProtocolError instead if it can't be played.
+    void onOpponentMove(ChessMove const& move);
+
+    void movePiece(Square src, Square dest); //dest must be empty
     void capturePiece(Vec2i location);
 
-    //called from piecePutDownRoutine() to see if the move being requested
-    //is in the vector of fully legal moves for the piece on the mouse
-    auto requestMove(Vec2i const& destinationSquare);
+    //called from putPieceDown() to see if the move being requested is one of
+    //the legal moves for the piece on the mouse. std::nullopt if it isn't.
+    std::optional<ChessMove> requestMove(Vec2i const& destinationSquare) const;
 
-    //loads up a fen string into the board. 
-    //makes some assumptions that the given string is a valid fen string.
-    //in the future I will probably make a seperate class for loading the 
-    //different portions of a fen string in order to break up this method which is a little lengthy
-    void loadFENIntoBoard(std::string_view fenString);
+    //Puts the pieces of fen on the (empty) board and takes the rest of the position from it.
+    void loadFENPosition(FENPosition const& fen);
 
     enum struct MateTypes {INVALID, CHECKMATE, STALEMATE};
 
     //std::nullopt means no check/stalemate has occurred.
-    std::optional<MateTypes> hasCheckOrStalemateOccurred();
+    std::optional<MateTypes> hasCheckOrStalemateOccurred() const;
+
+    enum struct DrawTypes {INVALID, THREEFOLD_REPETITION, FIFTY_MOVE_RULE, SEVENTY_FIVE_MOVE_RULE};
+
+    //std::nullopt means the game hasn't been drawn by repetition or by the 50/75 move rules.
+    std::optional<DrawTypes> hasDrawByRuleOccurred() const;
 
     //Helper function to reduce constructor size.
     void subToEvents();
@@ -64,7 +64,7 @@ public:
         if(mSubscriptions.contains(subscriptionTag))
             return false;
 
-        auto const ID { mSubscriber.sub<EventType>(std::move(callback)) };
+        auto const ID { mSubscriber.template sub<EventType>(std::move(callback)) };
         mSubscriptions.try_emplace(subscriptionTag, typeid(EventType), ID);
 
         return true;
@@ -270,6 +270,14 @@ namespace GUIEvents
     };
 
     struct CloseButtonClicked : Event {};
+
+    //Start playing against the computer (which plays engineSide) from the starting position.
+    //Side::INVALID stops the computer from playing either side.
+    struct PlayAgainstEngine : Event
+    {
+        PlayAgainstEngine(Side engineSide_) : engineSide{engineSide_} {}
+        Side engineSide {Side::INVALID};
+    };
 }
 
 using GUIEventSystem = EventSystem
@@ -288,7 +296,8 @@ using GUIEventSystem = EventSystem
     GUIEvents::DrawOffer,
     GUIEvents::PairRequest,
     GUIEvents::PairAccept,
-    GUIEvents::PromotionEnd
+    GUIEvents::PromotionEnd,
+    GUIEvents::PlayAgainstEngine
 >;
 
 namespace BoardEvents
@@ -313,13 +322,23 @@ namespace BoardEvents
         MoveCompleted(ChessMove move_) : move{move_} {}
         ChessMove move;
     };
+
+    //The opponent sent a move that can't be played (malformed, not one of the legal moves, not their turn or the game
+    //is over). The move isn't played so the board is left as it was. move is a default ChessMove if it was malformed.
+    struct ProtocolError : Event
+    {
+        ProtocolError(ChessMove move_, std::string reason_) : move{move_}, reason{std::move(reason_)} {}
+        ChessMove move;
+        std::string reason;
+    };
 }
 
 using BoardEventSystem = EventSystem
 <
     BoardEvents::GameOver,
     BoardEvents::PromotionBegin,
-    BoardEvents::MoveCompleted
+    BoardEvents::MoveCompleted,
+    BoardEvents::ProtocolError
 >;
 
 namespace NetworkEvents
@@ -332,6 +351,9 @@ namespace NetworkEvents
         ChessMove move;
     };
 
+    //The opponent sent a MOVE message that isn't a move at all (a square off the board or an unknown move type).
+    struct OpponentSentMalformedMove : Event {};
+
     struct DrawOffer : Event {};
     struct DrawDeclined : Event {};
 
@@ -378,6 +400,7 @@ using NetworkEventSystem = EventSystem
 <
     NetworkEvents::PairRequestWhilePaired,
     NetworkEvents::OpponentMadeMove,
+    NetworkEvents::OpponentSentMalformedMove,
     NetworkEvents::DrawOffer, 
     NetworkEvents::DrawDeclined,
     NetworkEvents::PairRequest,
@@ -417,6 +440,27 @@ namespace AppEvents
     };
 }
 
+namespace EngineEvents
+{
+    //Published from Engine::update() (on the main thread) once the search for the computer's move has finished.
+    struct BestMoveFound : Event
+    {
+        BestMoveFound(ChessMove move_, int score_, int depth_, uint64_t nodes_, uint64_t nodesPerSecond_) 
+            : move{move_}, score{score_}, depth{depth_}, nodes{nodes_}, nodesPerSecond{nodesPerSecond_} {}
+
+        ChessMove move;
+        int score {0}; //centipawns from the point of view of the side that is moving
+        int depth {0}; //the deepest iteration that was completed
+        uint64_t nodes {0}; //summed over every search thread
+        uint64_t nodesPerSecond {0};
+    };
+}
+
+using EngineEventSystem = EventSystem
+<
+    EngineEvents::BestMoveFound
+>;
+
 using AppEventSystem = EventSystem
 <
     AppEvents::LeftClickRelease,
@@ -1,5 +1,6 @@
 #pragma once
 #include <cstdint>
+#include <string>
 #include "Vector2i.hpp"
 #include "castleRights.hpp"
 
@@ -47,4 +48,25 @@ struct ChessMove
     //the defaulted c++20 spaceship operator allows compiler 
     //to supply default comparison operators for ChessMove
     auto operator<=>(ChessMove const&) const = default;
-};
\ No newline at end of file
+};
+
+//A move in coordinate notation (the notation UCI uses), e.g. e2e4 or e7e8q.
+inline std::string toCoordinateNotation(ChessMove const& move)
+{
+    std::string str
+    {
+        static_cast<char>('a' + move.src.x),  static_cast<char>('1' + move.src.y),
+        static_cast<char>('a' + move.dest.x), static_cast<char>('1' + move.dest.y)
+    };
+
+    switch(move.promoType)
+    {
+    case ChessMove::PromoTypes::QUEEN:  str += 'q'; break;
+    case ChessMove::PromoTypes::ROOK:   str += 'r'; break;
+    case ChessMove::PromoTypes::KNIGHT: str += 'n'; break;
+    case ChessMove::PromoTypes::BISHOP: str += 'b'; break;
+    default: break;
+    }
+
+    return str;
+}
@@ -3,6 +3,7 @@
 #include <cstdint>
 #include <optional>
 #include "SDL.h"
+#include "imgui.h"
 #include "Vector2i.hpp"
 #include "PopupManager.hpp"
 #include "ChessEvents.hpp"
@@ -71,7 +72,7 @@ private:
     void mainWindowDrawFileIndicatiors();
     void drawSidePanel(ImVec2 const& pos, ImVec2 const& size);
     //saves space in drawMainWindow()
-    void drawPieceOnMouse();
+    void drawPieceOnMouse(Board const&);
     void drawSquares();
     void drawPiecesNotOnMouse(Board const&);
     float drawMenuBar(Board const&, ConnectionManager const&);//returns menu bar height
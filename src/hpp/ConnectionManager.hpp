@@ -2,7 +2,9 @@
 #include "ChessMove.hpp"
 #include "ServerConnection.hpp"
 #include "ChessEvents.hpp"
+#include "ProtocolCodec.hpp"
 #include <string_view>
+#include <span>
 
 //how long (in seconds) the request to pair up will last before timing out
 #define PAIR_REQUEST_TIMEOUT_SECS 10
@@ -66,22 +68,24 @@ private:
 
     BoardEventSystem::Subscriber& mBoardEventSubscriber;
     SubscriptionID mMoveCompletedSubID {INVALID_SUBSCRIPTION_ID};
+    SubscriptionID mProtocolErrorSubID {INVALID_SUBSCRIPTION_ID};
 
 private:
 
-    using NetworkMessage  = std::vector<std::byte>;
-    using NetworkMessages = std::vector<NetworkMessage>;
+    //A whole message (header included) viewed straight out of ServerConnection's receive buffer.
+    //It is only valid until the next message is read.
+    using NetworkMessage = std::span<std::byte const>;
 
     void onConnect();
     void onDisconnect();
 
-    std::optional<NetworkMessages> retrieveNetworkMessages();
-
     //Helper to reduce processNetworkMessages() size.
-    void processNetworkMessage(NetworkMessage const&);//Helper to reduce processNetworkMessages() size.
+    void processNetworkMessage(NetworkMessage);//Helper to reduce processNetworkMessages() size.
     void processNetworkMessages();//Processes incoming network messages.
 
-    void sendHeaderOnlyMessage(MessageType msgType);
+    //Encodes msg (see ProtocolCodec.hpp) and sends it to the server.
+    template<ProtocolCodec::Message Msg>
+    void sendMessage(Msg const& msg);
 
     void buildAndSendMoveMsgType(ChessMove const& move);
     void buildAndSendPairRequest(uint32_t potentialOpponent);
@@ -93,22 +97,23 @@ private:
 
     //just to save space in subToEvents
     void onPairRequestEvent(GUIEvents::PairRequest const&);
+    void onProtocolErrorEvent(BoardEvents::ProtocolError const&);
 
     //helper method to reduce ctor size
     void subToEvents();
 
     //The message types that do not have a corresponding handle message 
     //function simply call publishEventNoData() inside of processNetworkMessage().
-    void handlePairRequestMessage(NetworkMessage const&);
-    void handlePairingCompleteMessage(NetworkMessage const&);
-    void handleMoveMessage(NetworkMessage const&);
+    void handlePairRequestMessage(NetworkMessage);
+    void handlePairingCompleteMessage(NetworkMessage);
+    void handleMoveMessage(NetworkMessage);
     void handleUnpairMessage();
     void handleInvalidMessageType();
     void handleRematchDeclineMessage();
     void handleOpponentClosedConnectionMessage();
-    void handleNewIDMessage(NetworkMessage const&);
-    void handlePairDeclineMessage(NetworkMessage const&);
-    void handleIDNotInLobbyMessage(NetworkMessage const& msg);
+    void handleNewIDMessage(NetworkMessage);
+    void handlePairDeclineMessage(NetworkMessage);
+    void handleIDNotInLobbyMessage(NetworkMessage msg);
 
 public:
     ConnectionManager(ConnectionManager const&)=delete;
@@ -0,0 +1,88 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "EngineSettings.hpp"
+#include "LazySMP.hpp"
+#include "Search.hpp"
+#include "ChessEvents.hpp"
+
+class Board;
+
+//The computer opponent. While it is playing a side (see GUIEvents::PlayAgainstEngine) and it is that side's turn,
+//a LazySMP search of the board's position is run on a worker thread so the main loop keeps rendering.
+//The number of search threads and the transposition table size come from engineSettings.txt (see EngineSettings). Once the search
+//finishes, update() publishes EngineEvents::BestMoveFound which the Board plays just like an opponent's move.
+class Engine
+{
+public:
+    Engine(Board const&, EngineEventSystem::Publisher const&, GUIEventSystem::Subscriber&,
+        NetworkEventSystem::Subscriber&);
+
+    //Call once per main loop iteration. Starts a search when it is the engine's turn
+    //and publishes the result of a finished search. Events are only ever published from here (the main thread).
+    void update();
+
+    bool isPlaying() const {return mEngineSide != Side::INVALID;}
+    Side getSide() const {return mEngineSide;}
+    bool isSearching() const {return mSearchThread.joinable();}
+
+private:
+    Board const& mBoard;
+    EngineEventSystem::Publisher const& mEngineEventPublisher;
+
+    enum struct SubscriptionTypes
+    {
+        PLAY_AGAINST_ENGINE,
+        PAIRING_COMPLETE
+    };
+
+    SubscriptionManager<SubscriptionTypes,
+        GUIEventSystem::Subscriber> mGuiSubManager;
+
+    SubscriptionManager<SubscriptionTypes,
+        NetworkEventSystem::Subscriber> mNetworkSubManager;
+
+    Side mEngineSide {Side::INVALID}; //Side::INVALID if the engine isn't playing
+
+    //How long the engine thinks about each move.
+    SearchLimits const mSearchLimits {.maxTime = std::chrono::milliseconds{1000}};
+
+    //Identifies the position being searched so a result can be thrown away if the
+    //board changed in the meantime (e.g. it was reset while the engine was thinking).
+    uint64_t mSearchedHash {0};
+    size_t mSearchedMoveCount {0};
+
+    //The board's move history copied over for LazySMP::setPosition(). Reused between searches.
+    std::vector<PackedMove> mGameMoves;
+
+    EngineSettings const mSettings {EngineSettings::load()};
+
+    //Kept between searches so the engine's next move can make use of what was found while searching this one.
+    TranspositionTable mTranspositionTable {mSettings.hashSizeMB};
+
+    //Only touched by the search thread while it is running. mResult is safe to read
+    //on the main thread once mIsResultReady is true (it is written before the flag is set).
+    LazySMP mSearch {mTranspositionTable, mSettings.numThreads};
+    LazySMP::Result mResult;
+    std::atomic<bool> mIsResultReady {false};
+
+    //Declared last so it is destroyed (stopped and joined) before everything the search thread uses.
+    std::jthread mSearchThread;
+
+    void startSearch();
+    void stopSearch();
+    bool isBoardStillAtSearchedPosition() const;
+
+    //Helper function to reduce constructor size.
+    void subToEvents();
+
+public:
+    Engine(Engine const&)=delete;
+    Engine(Engine&&)=delete;
+    Engine& operator=(Engine const&)=delete;
+    Engine& operator=(Engine&&)=delete;
+};
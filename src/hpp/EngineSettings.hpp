@@ -0,0 +1,13 @@
+#pragma once
+#include <cstddef>
+
+//The engine's settings from engineSettings.txt (read with a SettingsManager).
+//The file is generated with the defaults if it doesn't exist, and any value that is missing
+//or isn't a positive number is left at its default.
+struct EngineSettings
+{
+    int numThreads {1};        //how many threads the LazySMP search uses (load() defaults it to every core)
+    size_t hashSizeMB {64};    //the size of the transposition table
+
+    static EngineSettings load();
+};
@@ -0,0 +1,16 @@
+#pragma once
+#include <array>
+#include "Position.hpp"
+
+//Static evaluation used by the search. Material plus piece-square tables
+//(the "simplified evaluation function" from the chess programming wiki).
+namespace Evaluation
+{
+    //centipawns, indexed by PieceTypes
+    inline constexpr std::array<int, 7> s_pieceValues {0, 100, 500, 320, 330, 900, 0};
+
+    constexpr int getPieceValue(PieceTypes type) {return s_pieceValues[static_cast<size_t>(type)];}
+
+    //The score of the position in centipawns from the point of view of sideToMove (positive is good for sideToMove).
+    int evaluate(Position const& position, Side sideToMove);
+}
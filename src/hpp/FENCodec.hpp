@@ -0,0 +1,45 @@
+#pragma once
+#include <cstddef>
+#include <expected>
+#include <span>
+#include <string_view>
+
+#include "Bitboard.hpp"
+#include "castleRights.hpp"
+#include "chessNetworkProtocol.h" //enum Side
+#include "Position.hpp"
+
+//Everything a FEN string describes, in the terms of the board core.
+struct FENPosition
+{
+    Position position;
+    Side sideToMove {Side::WHITE};
+    CastleRights castleRights;
+    Square enPassantSquare {INVALID_SQUARE};
+    int halfmoveClock {0};
+    int fullmoveNumber {1};
+};
+
+//Why a FEN string couldn't be parsed and where.
+struct FENError
+{
+    size_t position {0};      //the index into the FEN string the problem was found at
+    std::string_view message; //always a string literal, so reporting an error doesn't allocate
+};
+
+//Reads and writes FEN strings without allocating, so loading a test suite of millions of positions
+//costs no more than the single pass over each string.
+namespace FENCodec
+{
+    //The longest FEN write() can produce (every rank full of alternating pieces and both clocks at INT_MAX) fits in this.
+    inline constexpr size_t MAX_LENGTH {128};
+
+    //The halfmove clock and fullmove number can be left off (like in an EPD record), in which case they are 0 and 1.
+    //Besides the syntax the position has to make sense: one king per side, no pawns on the first or last rank,
+    //castle rights only with the king and rook on their starting squares, an en passant square only right behind
+    //a pawn that has just moved two squares, and the side that just moved can't be in check.
+    std::expected<FENPosition, FENError> parse(std::string_view fen);
+
+    //Writes fen as a FEN string into out and returns the part of out that was written to.
+    std::string_view write(FENPosition const& fen, std::span<char, MAX_LENGTH> out);
+}
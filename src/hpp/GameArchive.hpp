@@ -0,0 +1,116 @@
+#pragma once
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#include "MappedFile.hpp"
+#include "PackedMove.hpp"
+
+//A compact binary archive of games for analytics jobs that need more speed than PGN can give.
+//It is two files: the archive itself and an index next to it (the archive's path with .idx on the end).
+//
+//archive: FileHeader, then one record per game, each starting on an 8 byte boundary:
+//           GameHeader
+//           the starting FEN (fenLength chars, none for the start position), padded to an even length
+//           the moves as PackedMove bits (numMoves uint16s)
+//index:   FileHeader, then where each game's record starts in the archive (one uint64 per game)
+//
+//Everything is little endian and laid out so the moves can be read straight out of the mapped file.
+//The record goes in before its index entry, so a game is either in the archive in full or isn't in it at all.
+namespace GameArchive
+{
+    enum struct Result : uint8_t {UNKNOWN, WHITE_WINS, BLACK_WINS, DRAW};
+
+    //1-0, 0-1, 1/2-1/2 and * (anything else is UNKNOWN too).
+    Result toResult(std::string_view pgnResult);
+    std::string_view toPGNResult(Result);
+
+    inline constexpr uint32_t VERSION {1};
+
+    struct FileHeader
+    {
+        std::array<char, 8> magic;
+        uint32_t version;
+        uint32_t reserved;
+    };
+
+    inline constexpr std::array<char, 8> ARCHIVE_MAGIC {'C', 'H', 'E', 'S', 'S', 'A', 'R', 'C'};
+    inline constexpr std::array<char, 8> INDEX_MAGIC   {'C', 'H', 'E', 'S', 'S', 'I', 'D', 'X'};
+
+    struct GameHeader
+    {
+        uint32_t numMoves;
+        uint16_t fenLength;
+        Result result;
+        uint8_t reserved;
+        int64_t unixTime; //when the game was played (or imported), in seconds
+    };
+
+    static_assert(sizeof(FileHeader) == 16 && sizeof(GameHeader) == 16);
+    static_assert(sizeof(PackedMove) == sizeof(uint16_t) && std::is_trivially_copyable_v<PackedMove>);
+    static_assert(std::endian::native == std::endian::little, "the archive is read and written as it is in memory");
+
+    std::filesystem::path getIndexPath(std::filesystem::path const& archivePath);
+
+    //A game in a mapped archive. The FEN and the moves point into the mapping so they are only valid while the Reader is.
+    struct Game
+    {
+        Result result;
+        int64_t unixTime;
+        std::string_view startingFEN; //empty for the start position
+        std::span<PackedMove const> moves;
+    };
+
+    //Appends games to an archive, creating it (and its index) if it doesn't exist.
+    class Writer
+    {
+    public:
+        explicit Writer(std::filesystem::path const& archivePath);
+
+        //False if the files couldn't be opened or aren't an archive of this version.
+        bool isOpen() const {return mIsOpen;}
+
+        //False if the game couldn't be written. startingFEN is empty for the start position, and isn't checked.
+        bool append(std::string_view startingFEN, std::span<PackedMove const> moves, Result, int64_t unixTime);
+
+    private:
+        std::ofstream mArchive;
+        std::ofstream mIndex;
+        uint64_t mArchiveSize {0}; //where the next record goes
+        bool mIsOpen {false};
+    };
+
+    //Maps an archive and its index for reading. getGame() is O(1): it reads the game's offset out of the
+    //index and points into the archive, with nothing parsed or copied.
+    class Reader
+    {
+    public:
+        //The error says what is wrong if either file can't be mapped or has the wrong header.
+        static std::expected<Reader, std::string> open(std::filesystem::path const& archivePath);
+
+        size_t getNumGames() const {return mOffsets.size();}
+
+        //The game at index (from 0, in the order they were added). std::nullopt if its record runs off the
+        //end of the archive, which only happens if the files have been damaged.
+        std::optional<Game> getGame(size_t index) const;
+
+        //For reading every game in order (see MappedFile::adviseSequential()).
+        void adviseSequential() const;
+
+    private:
+        Reader(MappedFile archive, MappedFile index);
+
+        MappedFile mArchive;
+        MappedFile mIndex;
+        std::span<uint64_t const> mOffsets;
+    };
+}
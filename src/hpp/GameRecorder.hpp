@@ -0,0 +1,38 @@
+#pragma once
+#include <filesystem>
+
+#include "ChessEvents.hpp"
+#include "GameArchive.hpp"
+#include "PGN.hpp"
+
+class Board;
+
+//Keeps a record of every game played on the Board. When a game ends (BoardEvents::GameOver) its starting position
+//and moves are appended to a PGN file and to a binary game archive (see GameArchive.hpp), so games.pgn and
+//games.archive build up into databases of everything played.
+class GameRecorder
+{
+public:
+    GameRecorder(Board const&, BoardEventSystem::Subscriber&, std::filesystem::path pgnFilePath = "games.pgn",
+        std::filesystem::path const& archiveFilePath = "games.archive");
+    ~GameRecorder();
+
+private:
+    Board const& mBoard;
+    BoardEventSystem::Subscriber& mBoardEventSubscriber;
+    SubscriptionID mGameOverSubID {INVALID_SUBSCRIPTION_ID};
+
+    std::filesystem::path const mPGNFilePath;
+    PGNWriter mPGNWriter;
+    PGNGame mGame; //reused from game to game
+
+    GameArchive::Writer mArchiveWriter;
+
+    void onGameOver(BoardEvents::GameOver const&);
+
+public:
+    GameRecorder(GameRecorder const&)=delete;
+    GameRecorder(GameRecorder&&)=delete;
+    GameRecorder& operator=(GameRecorder const&)=delete;
+    GameRecorder& operator=(GameRecorder&&)=delete;
+};
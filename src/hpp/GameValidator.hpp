@@ -0,0 +1,73 @@
+#pragma once
+#include <cstddef>
+#include <istream>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "FENCodec.hpp"
+#include "HeadlessBoard.hpp"
+#include "PackedMove.hpp"
+#include "TestPositions.hpp"
+
+//The moves of a game and the position it started from.
+//A null PackedMove stands for a move that couldn't even be decoded, which is never legal.
+struct RecordedGame
+{
+    std::string startingFEN {TestPositions::defaultPositionFEN};
+    std::vector<PackedMove> moves;
+};
+
+//Why a RecordedGame isn't valid.
+struct GameError
+{
+    enum struct Type
+    {
+        BAD_FEN,     //startingFEN can't be parsed, so none of the moves could be played (fenError says why)
+        ILLEGAL_MOVE //moveIdx is the index into game.moves of the first move that isn't legal
+    };
+
+    Type type;
+    size_t moveIdx {0};
+    FENError fenError {};
+};
+
+//Replays recorded games (from the server's message stream for example) on a Board of its own,
+//checking every move against the legal moves of the position it was played in.
+//A GameValidator is only used by one thread at a time. validateGames() gives each thread its own.
+class GameValidator
+{
+public:
+    GameValidator()=default;
+
+    //The first thing wrong with game, std::nullopt if it starts from a valid FEN and every move is legal.
+    //The flags have to match too, so a move claiming to be a capture when it isn't is illegal.
+    std::optional<GameError> findFirstError(RecordedGame const& game);
+
+    //Validates every game, splitting them between numThreads threads which each replay them on their own Board.
+    //The result at index i is findFirstError() of games[i].
+    static std::vector<std::optional<GameError>> validateGames(std::span<RecordedGame const> games, int numThreads);
+
+    //Splits a stream of protocol messages (chessNetworkProtocol.h) into games. A PAIRING_COMPLETE or
+    //REMATCH_ACCEPT message starts a new game from the start position (like in the app), MOVE messages are
+    //the game's moves and every other message is skipped over. A MOVE message that doesn't decode is kept as
+    //a null move so its game gets flagged. The stream ends early at a header that isn't a MessageType followed by
+    //that type's size (see ProtocolCodec::isValidHeader()) or one that runs past the end of the stream, in which
+    //case the game being read gets a null move too.
+    static std::vector<RecordedGame> parseMessageStream(std::span<std::byte const> stream);
+
+    //Reads every game of a PGN file (see PGNReader) into games starting from their FEN tag (or the start position).
+    //A game with a move PGNReader couldn't play gets a null move in its place, so its game gets flagged at that move.
+    //A FEN tag that can't be parsed is kept as the game's startingFEN, so its game gets flagged as a bad FEN.
+    static std::vector<RecordedGame> parsePGN(std::istream& in);
+
+private:
+    HeadlessBoard mBoard;
+
+public:
+    GameValidator(GameValidator const&)=delete;
+    GameValidator(GameValidator&&)=delete;
+    GameValidator& operator=(GameValidator const&)=delete;
+    GameValidator& operator=(GameValidator&&)=delete;
+};
@@ -0,0 +1,28 @@
+#pragma once
+#include "Board.hpp"
+#include "ChessEvents.hpp"
+
+//The event systems a Board has to be given. A base class of HeadlessBoard (rather than members) only so
+//they are constructed before the Board they are given to.
+struct HeadlessEventSystems
+{
+    BoardEventSystem boardEventSys;
+    GUIEventSystem guiEventSys;
+    NetworkEventSystem networkEventSys;
+    AppEventSystem appEventSys;
+    EngineEventSystem engineEventSys;
+};
+
+//A Board with no GUI, network or app around it, for the search, the PGN reader/writer, the game validator and the
+//headless tools. It owns the event systems the Board needs, which nothing subscribes to, so it can be used
+//anywhere a Board can.
+class HeadlessBoard : private HeadlessEventSystems, public Board
+{
+public:
+    HeadlessBoard();
+
+    HeadlessBoard(HeadlessBoard const&)=delete;
+    HeadlessBoard(HeadlessBoard&&)=delete;
+    HeadlessBoard& operator=(HeadlessBoard const&)=delete;
+    HeadlessBoard& operator=(HeadlessBoard&&)=delete;
+};
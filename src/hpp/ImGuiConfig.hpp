@@ -0,0 +1,11 @@
+#pragma once
+#include "Vector2i.hpp"
+
+//ImGui user config (see imconfig.h). CMakeLists.txt points IMGUI_USER_CONFIG at this file
+//for the Chess app, so it gets included by imgui.h right before ImVec2 is defined.
+
+//Lets an ImVec2 and a Vec2i be implicitly converted to each other.
+//Declaring the conversions on the ImGui side keeps Vector2i.hpp free of any ImGui dependency.
+#define IM_VEC2_CLASS_EXTRA                                                                         \
+    constexpr ImVec2(Vec2i const& v) : x{static_cast<float>(v.x)}, y{static_cast<float>(v.y)} {} \
+    constexpr operator Vec2i() const {return Vec2i{static_cast<int>(x), static_cast<int>(y)};}
@@ -0,0 +1,61 @@
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <stop_token>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Search.hpp"
+#include "TranspositionTable.hpp"
+
+//Lazy SMP parallel search. Every thread runs its own Search of the same root position and they only
+//cooperate through the shared transposition table: whatever one thread finds, the others can cut off with.
+//The helper threads search in a slightly different order and to different depths (see Search's threadIndex)
+//so they don't all search the same nodes. The move played comes from the main thread, which runs on the
+//thread calling run(). The helpers are stopped as soon as it finishes.
+class LazySMP
+{
+public:
+    struct Result
+    {
+        SearchResult mainThreadResult; //the best move, score and depth
+        std::vector<uint64_t> nodesPerThread; //index 0 is the main thread
+        uint64_t totalNodes {0};
+        uint64_t totalTTProbes {0}; //summed from every thread's SearchResult
+        uint64_t totalTTHits {0};
+        double seconds {0.0};
+
+        uint64_t getNodesPerSecond() const {return seconds > 0.0 ? static_cast<uint64_t>(totalNodes / seconds) : 0;}
+
+        //For tuning the table size: the fraction of transposition table lookups that found an entry.
+        double getTTHitRate() const {return totalTTProbes ? static_cast<double>(totalTTHits) / static_cast<double>(totalTTProbes) : 0.0;}
+    };
+
+    LazySMP(TranspositionTable&, int numThreads);
+
+    //Must not be called during run().
+    void setNumThreads(int numThreads);
+    int getNumThreads() const {return static_cast<int>(mSearches.size());}
+
+    //Like Search::setPosition(). The position is only copied here. Each thread sets up its own Board when run() starts.
+    void setPosition(std::string_view fen, std::span<PackedMove const> moves);
+
+    //Blocks until the main thread's search is done (see Search::run()).
+    Result run(SearchLimits const& limits, std::stop_token stopToken = {});
+
+private:
+    TranspositionTable& mTranspositionTable;
+    std::vector<std::unique_ptr<Search>> mSearches; //one per thread, index 0 is the main thread
+    std::vector<SearchResult> mResults;
+
+    std::string mFEN;
+    std::vector<PackedMove> mMoves;
+
+public:
+    LazySMP(LazySMP const&)=delete;
+    LazySMP(LazySMP&&)=delete;
+    LazySMP& operator=(LazySMP const&)=delete;
+    LazySMP& operator=(LazySMP&&)=delete;
+};
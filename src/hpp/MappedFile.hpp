@@ -0,0 +1,36 @@
+#pragma once
+#include <cstddef>
+#include <expected>
+#include <filesystem>
+#include <span>
+#include <string>
+
+//A whole file mapped read only into memory (mmap, or a file mapping on Windows). The pages are only read in
+//from disk as they are touched, so a file much bigger than memory can be read as if it was one big array.
+class MappedFile
+{
+public:
+    //An empty file maps to an empty span. The error says what went wrong if the file can't be mapped.
+    static std::expected<MappedFile, std::string> open(std::filesystem::path const&);
+
+    std::span<std::byte const> getBytes() const {return {mData, mSize};}
+
+    //Lets the OS know the file is about to be read from front to back, so it reads ahead further.
+    void adviseSequential() const;
+
+    MappedFile(MappedFile&&) noexcept;
+    MappedFile& operator=(MappedFile&&) noexcept;
+    ~MappedFile();
+
+private:
+    MappedFile()=default;
+
+    std::byte const* mData {nullptr};
+    size_t mSize {0};
+
+    void unmap();
+
+public:
+    MappedFile(MappedFile const&)=delete;
+    MappedFile& operator=(MappedFile const&)=delete;
+};
@@ -0,0 +1,40 @@
+#pragma once
+#include <cstdint>
+#include "Bitboard.hpp"
+#include "MoveList.hpp"
+#include "chessNetworkProtocol.h" //enum Side
+
+class Board;
+class Position;
+
+//Bitboard legal move generation for the side to move on a Board. The moves are written into a MoveList,
+//so generating them never allocates. The generation is split into stages so a search can ask for
+//just the moves it is going to look at first (the quiescence search only ever wants captures and promotions).
+//Each promotion is listed once per piece the pawn can promote to.
+namespace MoveGen
+{
+    enum struct Stage : uint8_t
+    {
+        CAPTURES,   //captures (en passant included) that aren't promotions
+        PROMOTIONS, //every promotion, by a push or by a capture
+        QUIETS,     //everything else: pawn pushes, castling and the pieces' non captures
+        EVASIONS    //every legal move, for when the side to move is in check
+    };
+
+    //Appends the legal moves of stage for the side to move. When not in check CAPTURES, PROMOTIONS and QUIETS
+    //don't overlap and together are every legal move. When in check use EVASIONS instead.
+    void generate(Board const&, Stage, MoveList& out);
+
+    //Every legal move for the side to move. out is cleared first.
+    void generateLegalMoves(Board const&, MoveList& out);
+
+    //The pieces of attackingSide that attack sq, with occupied as the squares that block the sliding pieces.
+    Bitboard getAttackersTo(Position const&, Square sq, Side attackingSide, Bitboard occupied);
+
+    //The pieces of side that are the only piece standing between their king and an enemy slider looking at it.
+    //Found by looking out from the king along the rook and bishop rays, so it is a handful of table lookups.
+    Bitboard getPinnedPieces(Position const&, Side side);
+
+    //True if a pawn of side can legally capture en passant onto epSq (pins and checks included).
+    bool canCaptureEnPassant(Position const&, Side side, Square epSq);
+}
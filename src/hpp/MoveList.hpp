@@ -0,0 +1,40 @@
+#pragma once
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include "PackedMove.hpp"
+
+//A list of moves with room for every move of any reachable position (the most known is 218) stored inline,
+//so a MoveList can live on the stack or be reused per ply without ever touching the heap.
+//The moves are PackedMoves so a whole list is only half a kilobyte.
+class MoveList
+{
+public:
+    static constexpr size_t CAPACITY {256};
+
+    void push_back(PackedMove const move)
+    {
+        assert(mSize < CAPACITY);
+        mMoves[mSize++] = move;
+    }
+
+    void clear() {mSize = 0;}
+
+    size_t size() const {return mSize;}
+    bool empty() const {return mSize == 0;}
+
+    PackedMove& operator[](size_t i) {assert(i < mSize); return mMoves[i];}
+    PackedMove const& operator[](size_t i) const {assert(i < mSize); return mMoves[i];}
+
+    PackedMove* begin() {return mMoves.data();}
+    PackedMove* end() {return mMoves.data() + mSize;}
+    PackedMove const* begin() const {return mMoves.data();}
+    PackedMove const* end() const {return mMoves.data() + mSize;}
+
+    PackedMove& front() {assert(mSize > 0); return mMoves[0];}
+    PackedMove const& front() const {assert(mSize > 0); return mMoves[0];}
+
+private:
+    std::array<PackedMove, CAPACITY> mMoves;
+    size_t mSize {0};
+};
@@ -0,0 +1,115 @@
+#pragma once
+#include <cstddef>
+#include <istream>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "HeadlessBoard.hpp"
+#include "PackedMove.hpp"
+#include "TestPositions.hpp"
+
+struct PGNTag
+{
+    std::string name;
+    std::string value;
+};
+
+//Where PGNReader gave up on a game. line counts from 1.
+struct PGNError
+{
+    size_t line;
+    std::string_view message;
+    std::string token; //the SAN move or FEN that couldn't be used
+};
+
+//A game as it is in a PGN file. The moves are kept as PackedMoves (not SAN) so they can be played straight onto a Board.
+struct PGNGame
+{
+    //Every tag in the order it was read or is to be written (the FEN and SetUp tags are written from startingFEN).
+    std::vector<PGNTag> tags;
+
+    std::string startingFEN {TestPositions::defaultPositionFEN};
+    std::vector<PackedMove> moves;
+    std::string result {"*"}; //1-0, 0-1, 1/2-1/2 or *
+
+    //Set by PGNReader if a move (or the FEN tag) couldn't be used. moves holds the moves before it.
+    std::optional<PGNError> error;
+
+    //The value of the tag called name, empty if there isn't one.
+    std::string_view getTag(std::string_view name) const;
+    void setTag(std::string_view name, std::string_view value);
+
+    //Empties the game but keeps the memory the vectors and strings have already allocated.
+    void clear();
+};
+
+//Writes games as PGN in export format: the seven tag roster first, then the rest of the tags,
+//then the moves in SAN on lines of at most 79 characters. Owns a Board to replay the moves on for their SAN.
+class PGNWriter
+{
+public:
+    PGNWriter();
+
+    //Every move of game has to be legal. A game that starts from a position other than the start position
+    //gets SetUp and FEN tags.
+    void write(std::ostream& out, PGNGame const& game);
+
+private:
+    HeadlessBoard mBoard;
+    std::string mLine; //the movetext line being filled up
+
+public:
+    PGNWriter(PGNWriter const&)=delete;
+    PGNWriter(PGNWriter&&)=delete;
+    PGNWriter& operator=(PGNWriter const&)=delete;
+    PGNWriter& operator=(PGNWriter&&)=delete;
+};
+
+//Reads the games of a PGN file one at a time, so a database of any size is read in constant memory.
+//The stream is read in fixed size chunks and nothing is kept between games except the chunk being read.
+//Each SAN move is matched against the legal moves of the position on the reader's own Board (see SANCodec::parse()).
+//Comments, variations, NAGs and escape lines are skipped over.
+class PGNReader
+{
+public:
+    explicit PGNReader(std::istream& in);
+
+    //Reads the next game into game, reusing the memory it already has. False once there are no games left.
+    //A game that has a move which can't be played is still read to its end, with game.error set.
+    bool readGame(PGNGame& game);
+
+private:
+    static constexpr size_t CHUNK_SIZE {64 * 1024};
+
+    std::istream& mIn;
+    std::vector<char> mChunk;
+    size_t mChunkPos {0};
+    size_t mChunkEnd {0};
+    size_t mLineNumber {1};
+    bool mIsAtLineStart {true};
+
+    std::string mToken;
+
+    HeadlessBoard mBoard;
+
+    //The next character of the stream without/with moving past it. EOF at the end of the stream.
+    int peek();
+    int get();
+
+    void readTag(PGNGame&);
+    void skipUntil(char end);
+    void skipVariation();
+    void readToken();
+
+    //Sets up mBoard for the moves of game (from its FEN tag if it has one). False if the FEN can't be used.
+    bool startMovetext(PGNGame&);
+
+public:
+    PGNReader(PGNReader const&)=delete;
+    PGNReader(PGNReader&&)=delete;
+    PGNReader& operator=(PGNReader const&)=delete;
+    PGNReader& operator=(PGNReader&&)=delete;
+};
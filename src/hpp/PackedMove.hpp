@@ -0,0 +1,136 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include "Bitboard.hpp"
+#include "ChessMove.hpp"
+#include "castleRights.hpp"
+
+//A move in 16 bits, for the places that hold a lot of moves (move lists, the undo stack, the transposition table).
+//
+// bits 0-5   the source square
+// bits 6-11  the destination square
+// bits 12-15 the flags: PROMOTION | CAPTURE | two bits that are either the promotion piece or
+//            which special move it is (see the flag values below)
+//
+//Everything else in a ChessMove follows from these bits: the castle rights to revoke only depend on
+//which squares are moved from and to (see getRightsToRevoke()), so toChessMove() gives back exactly the
+//ChessMove that was packed, as long as its rightsToRevoke were worked out the same way (the generator's are).
+//wasOpponentsMove isn't part of a move, it is only filled in by Board::commitMove() for the rest of the app.
+//A default constructed PackedMove is a null move (a1 to a1) which converts to a ChessMove with an INVALID moveType.
+class PackedMove
+{
+public:
+    static constexpr uint8_t QUIET       {0};
+    static constexpr uint8_t DOUBLE_PUSH {1};
+    static constexpr uint8_t CASTLE      {2};
+    static constexpr uint8_t CAPTURE     {4}; //also set for en passant and capturing promotions
+    static constexpr uint8_t EN_PASSANT  {CAPTURE | 1};
+    static constexpr uint8_t PROMOTION   {8}; //the low two bits are the ChessMove::PromoTypes - 1
+
+    constexpr PackedMove()=default;
+
+    constexpr PackedMove(Square from, Square to, uint8_t flags)
+        : mBits{static_cast<uint16_t>(from | (to << 6) | (flags << 12))} {}
+
+    constexpr static PackedMove makePromotion(Square from, Square to, ChessMove::PromoTypes promoType, bool isCapture)
+    {
+        return {from, to, static_cast<uint8_t>(PROMOTION | (isCapture ? CAPTURE : 0) | (static_cast<uint8_t>(promoType) - 1))};
+    }
+
+    explicit PackedMove(ChessMove const& move)
+    {
+        using enum ChessMove::MoveTypes;
+        if(move.moveType == INVALID)
+            return;
+
+        Square const from {toSquare(move.src)};
+        Square const to {toSquare(move.dest)};
+
+        switch(move.moveType)
+        {
+        case DOUBLE_PUSH: *this = {from, to, PackedMove::DOUBLE_PUSH}; break;
+        case ENPASSANT:   *this = {from, to, PackedMove::EN_PASSANT}; break;
+        case CASTLE:      *this = {from, to, PackedMove::CASTLE}; break;
+        case PROMOTION:   *this = makePromotion(from, to, move.promoType, move.wasCapture); break;
+        default:          *this = {from, to, move.wasCapture ? CAPTURE : QUIET}; break;
+        }
+    }
+
+    constexpr static PackedMove fromBits(uint16_t bits) {PackedMove move; move.mBits = bits; return move;}
+    constexpr uint16_t getBits() const {return mBits;}
+
+    constexpr Square getFrom() const {return mBits & 0x3F;}
+    constexpr Square getTo() const {return (mBits >> 6) & 0x3F;}
+    constexpr uint8_t getFlags() const {return static_cast<uint8_t>(mBits >> 12);}
+
+    constexpr bool isCapture() const {return getFlags() & CAPTURE;}
+    constexpr bool isPromotion() const {return getFlags() & PROMOTION;}
+    constexpr bool isEnPassant() const {return getFlags() == EN_PASSANT;}
+    constexpr bool isCastle() const {return getFlags() == CASTLE;}
+    constexpr bool isDoublePush() const {return getFlags() == DOUBLE_PUSH;}
+
+    constexpr ChessMove::PromoTypes getPromoType() const
+    {
+        return isPromotion() ? static_cast<ChessMove::PromoTypes>((getFlags() & 0b11) + 1) : ChessMove::PromoTypes::INVALID;
+    }
+
+    constexpr ChessMove::MoveTypes getMoveType() const
+    {
+        using enum ChessMove::MoveTypes;
+        if( ! *this )        return INVALID;
+        if(isPromotion())    return PROMOTION;
+        if(isEnPassant())    return ENPASSANT;
+        if(isCastle())       return CASTLE;
+        if(isDoublePush())   return DOUBLE_PUSH;
+        return NORMAL;
+    }
+
+    //A move from a rook's starting corner or onto it (capturing the rook) takes away that rook's castle right,
+    //and a move from a king's starting square takes away both of that side's rights. A square can only be
+    //moved from or onto like this while its rights are still there if it is that rook or king, so the
+    //squares alone are enough. Whatever rights a side has already lost being revoked again doesn't matter.
+    CastleRights getRightsToRevoke() const
+    {
+        return CastleRights{static_cast<unsigned char>(s_rightsLostBySquare[getFrom()] | s_rightsLostBySquare[getTo()])};
+    }
+
+    ChessMove toChessMove() const
+    {
+        if( ! *this )
+            return ChessMove{};
+
+        return ChessMove{toChessPos(getFrom()), toChessPos(getTo()), isCapture(),
+            getMoveType(), getRightsToRevoke(), getPromoType()};
+    }
+
+    //false for the null move
+    constexpr explicit operator bool() const {return mBits != 0;}
+
+    constexpr bool operator==(PackedMove const&) const = default;
+
+private:
+    uint16_t mBits {0};
+
+    //The CastleRights bits (see CastleRights::Rights) taken away by moving from or onto each square.
+    static constexpr std::array<uint8_t, 64> s_rightsLostBySquare
+    {
+        []
+        {
+            constexpr uint8_t wShort {1 << static_cast<int>(CastleRights::Rights::WSHORT)};
+            constexpr uint8_t wLong  {1 << static_cast<int>(CastleRights::Rights::WLONG)};
+            constexpr uint8_t bShort {1 << static_cast<int>(CastleRights::Rights::BSHORT)};
+            constexpr uint8_t bLong  {1 << static_cast<int>(CastleRights::Rights::BLONG)};
+
+            std::array<uint8_t, 64> rights {};
+            rights[toSquare({0, 0})] = wLong;
+            rights[toSquare({7, 0})] = wShort;
+            rights[toSquare({4, 0})] = wLong | wShort;
+            rights[toSquare({0, 7})] = bLong;
+            rights[toSquare({7, 7})] = bShort;
+            rights[toSquare({4, 7})] = bLong | bShort;
+            return rights;
+        }()
+    };
+};
+
+static_assert(sizeof(PackedMove) == 2);
@@ -0,0 +1,27 @@
+#pragma once
+#include <cstdint>
+#include "chessNetworkProtocol.h" //enum Side
+
+enum struct PieceTypes : uint8_t {INVALID = 0, PAWN, ROOK, KNIGHT, BISHOP, QUEEN, KING};
+
+//One byte description of what is on a square. The low 3 bits hold the PieceTypes
+//and the next 2 bits hold the Side. A default constructed PieceCode is an empty square.
+class PieceCode
+{
+public:
+    constexpr PieceCode()=default;
+    constexpr PieceCode(Side side, PieceTypes type)
+        : mBits{static_cast<uint8_t>(static_cast<uint8_t>(type) | (static_cast<uint8_t>(side) << 3))} {}
+
+    constexpr PieceTypes getType() const {return static_cast<PieceTypes>(mBits & 0b111);}
+    constexpr Side getSide() const {return static_cast<Side>(mBits >> 3);}
+    constexpr bool isEmpty() const {return mBits == 0;}
+
+    //Lets a PieceCode be tested like the shared_ptr<Piece> returned from Board::getPieceAt().
+    constexpr explicit operator bool() const {return mBits != 0;}
+
+    auto operator<=>(PieceCode const&) const = default;
+
+private:
+    uint8_t mBits {0};
+};
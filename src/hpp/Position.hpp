@@ -0,0 +1,82 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <cassert>
+#include "Bitboard.hpp"
+#include "PieceCode.hpp"
+#include "Zobrist.hpp"
+
+//The placement of the pieces as bitboards (one per piece type and one per side)
+//plus a mailbox of PieceCodes for O(1) "what is on this square" lookups.
+//Both views are kept in sync by putPiece(), removePiece() and movePiece().
+//The Zobrist hash of the piece placement is kept up to date the same way (see Zobrist.hpp).
+//This class does not allocate, so it can be probed from the move generation code
+//without the atomic ref counting that comes with copying a shared_ptr<Piece>.
+class Position
+{
+public:
+
+    void putPiece(Square sq, PieceCode code)
+    {
+        assert(mMailbox[sq].isEmpty() && ! code.isEmpty());
+        Bitboard const bb {squareBB(sq)};
+        mTypeBitboards[static_cast<size_t>(code.getType())] |= bb;
+        mSideBitboards[static_cast<size_t>(code.getSide())] |= bb;
+        mMailbox[sq] = code;
+        mPiecesHash ^= Zobrist::getPieceKey(code, sq);
+    }
+
+    void removePiece(Square sq)
+    {
+        PieceCode const code {mMailbox[sq]};
+        if(code.isEmpty())
+            return;
+
+        Bitboard const bb {squareBB(sq)};
+        mTypeBitboards[static_cast<size_t>(code.getType())] &= ~bb;
+        mSideBitboards[static_cast<size_t>(code.getSide())] &= ~bb;
+        mMailbox[sq] = PieceCode{};
+        mPiecesHash ^= Zobrist::getPieceKey(code, sq);
+    }
+
+    //The destination square must be empty (remove any captured piece first).
+    void movePiece(Square from, Square to)
+    {
+        PieceCode const code {mMailbox[from]};
+        assert( ! code.isEmpty() && mMailbox[to].isEmpty() );
+
+        Bitboard const fromTo {squareBB(from) | squareBB(to)};
+        mTypeBitboards[static_cast<size_t>(code.getType())] ^= fromTo;
+        mSideBitboards[static_cast<size_t>(code.getSide())] ^= fromTo;
+        mMailbox[from] = PieceCode{};
+        mMailbox[to] = code;
+        mPiecesHash ^= Zobrist::getPieceKey(code, from) ^ Zobrist::getPieceKey(code, to);
+    }
+
+    void clear() {*this = Position{};}
+
+    PieceCode pieceAt(Square sq) const {return mMailbox[sq];}
+    PieceCode pieceAt(Vec2i chessPos) const {return mMailbox[toSquare(chessPos)];}
+
+    Bitboard getPieces(PieceTypes type) const {return mTypeBitboards[static_cast<size_t>(type)];}
+    Bitboard getPieces(Side side) const {return mSideBitboards[static_cast<size_t>(side)];}
+    Bitboard getPieces(Side side, PieceTypes type) const {return getPieces(side) & getPieces(type);}
+    Bitboard getOccupied() const {return mSideBitboards[static_cast<size_t>(Side::WHITE)] |
+        mSideBitboards[static_cast<size_t>(Side::BLACK)];}
+
+    //The XOR of the Zobrist key of every piece on the board. Board::getHash() adds the rest of the position to it.
+    uint64_t getPiecesHash() const {return mPiecesHash;}
+
+    //INVALID_SQUARE if side has no king on the board.
+    Square getKingSquare(Side side) const
+    {
+        Bitboard const king {getPieces(side, PieceTypes::KING)};
+        return king ? lsb(king) : INVALID_SQUARE;
+    }
+
+private:
+    std::array<Bitboard, 7> mTypeBitboards {}; //indexed by PieceTypes
+    std::array<Bitboard, 3> mSideBitboards {}; //indexed by Side
+    std::array<PieceCode, 64> mMailbox {};
+    uint64_t mPiecesHash {0};
+};
@@ -0,0 +1,278 @@
+#pragma once
+#include <array>
+#include <span>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <tuple>
+#include <type_traits>
+#include "chessNetworkProtocol.h"
+#include "PackedMove.hpp"
+
+//Turns the messages described in chessNetworkProtocol.h into bytes and back again.
+//There is no socket code in here (multi byte values are put into network byte order by hand),
+//so the client, the headless tools and any benchmarks all share the same message layout code.
+//
+//Each message is a struct that declares its MessageType and its fields (in the order they go after the header)
+//once, in getFields(). encode() and decode() are generated from that at compile time: every field is at a fixed
+//offset so they are just a run of loads and stores with no branches, and the size the fields add up to is
+//checked against the MessageSize in chessNetworkProtocol.h with a static_assert.
+namespace ProtocolCodec
+{
+    //Every message starts with a two byte header (MessageType then MessageSize).
+    inline constexpr size_t HEADER_SIZE {2};
+
+    //The MessageSize that goes with each MessageType in chessNetworkProtocol.h (the two enums aren't in the same order).
+    //0 for a byte that isn't a MessageType.
+    constexpr uint8_t getMessageSize(MessageType const msgType)
+    {
+        auto const size = [](MessageSize s){ return static_cast<uint8_t>(s); };
+
+        switch(msgType)
+        {
+        using enum MessageType;
+        case MOVE_MSGTYPE:                       return size(MessageSize::MOVE_MSGSIZE);
+        case RESIGN_MSGTYPE:                     return size(MessageSize::RESIGN_MSGSIZE);
+        case DRAW_OFFER_MSGTYPE:                 return size(MessageSize::DRAW_OFFER_MSGSIZE);
+        case DRAW_ACCEPT_MSGTYPE:                return size(MessageSize::DRAW_ACCEPT_MSGSIZE);
+        case DRAW_DECLINE_MSGTYPE:               return size(MessageSize::DRAW_DECLINE_MSGSIZE);
+        case REMATCH_REQUEST_MSGTYPE:            return size(MessageSize::REMATCH_REQUEST_MSGSIZE);
+        case REMATCH_ACCEPT_MSGTYPE:             return size(MessageSize::REMATCH_ACCEPT_MSGSIZE);
+        case PAIRING_COMPLETE_MSGTYPE:           return size(MessageSize::PAIR_COMPLETE_MSGSIZE);
+        case PAIR_REQUEST_MSGTYPE:               return size(MessageSize::PAIR_REQUEST_MSGSIZE);
+        case PAIR_ACCEPT_MSGTYPE:                return size(MessageSize::PAIR_ACCEPT_MSGSIZE);
+        case PAIR_DECLINE_MSGTYPE:               return size(MessageSize::PAIR_DECLINE_MSGSIZE);
+        case PAIR_NORESPONSE_MSGTYPE:            return size(MessageSize::PAIR_NORESPONSE_MSGSIZE);
+        case SERVER_FULL_MSGTYPE:                return size(MessageSize::SERVER_FULL_MSGSIZE);
+        case ID_NOT_IN_LOBBY_MSGTYPE:            return size(MessageSize::ID_NOT_IN_LOBBY_MSGSIZE);
+        case UNPAIR_MSGTYPE:                     return size(MessageSize::UNPAIR_MSGSIZE);
+        case OPPONENT_CLOSED_CONNECTION_MSGTYPE: return size(MessageSize::OPPONENT_CLOSED_CONNECTION_MSGSIZE);
+        case REMATCH_DECLINE_MSGTYPE:            return size(MessageSize::REMATCH_DECLINE_MSGSIZE);
+        case PAIR_REQUEST_TOO_SOON_MSGTYPE:      return size(MessageSize::PAIR_REQUEST_TOO_SOON_MSGSIZE);
+        case NEW_ID_MSGTYPE:                     return size(MessageSize::NEW_ID_MSGSIZE);
+        }
+
+        return 0;
+    }
+
+    //getMessageSize() for every possible first byte of a message, so a header can be checked with one lookup.
+    inline constexpr std::array<uint8_t, 256> MESSAGE_SIZES {[]
+    {
+        std::array<uint8_t, 256> sizes {};
+        for(size_t i = 0; i < sizes.size(); ++i)
+            sizes[i] = getMessageSize(static_cast<MessageType>(i));
+        return sizes;
+    }()};
+
+    //Every MessageType is in the table (NEW_ID_MSGTYPE is the last one) and has room for its header.
+    static_assert([]
+    {
+        for(size_t i = 0; i <= static_cast<size_t>(MessageType::NEW_ID_MSGTYPE); ++i)
+        {
+            if(MESSAGE_SIZES[i] < HEADER_SIZE)
+                return false;
+        }
+        return MESSAGE_SIZES[static_cast<size_t>(MessageType::NEW_ID_MSGTYPE) + 1] == 0;
+    }());
+
+    //True if the two header bytes are a MessageType followed by that type's MessageSize. Any other header
+    //means the stream of messages can't be trusted to be split up in the right places anymore.
+    constexpr bool isValidHeader(std::byte const msgType, std::byte const msgSize)
+    {
+        return MESSAGE_SIZES[std::to_integer<size_t>(msgType)] == std::to_integer<uint8_t>(msgSize) &&
+               std::to_integer<uint8_t>(msgSize) != 0;
+    }
+
+    //A message's fields are integers or enums (bools would be a byte that could be anything but 0 or 1).
+    template<typename T>
+    concept Field = (std::is_integral_v<T> || std::is_enum_v<T>) && ! std::is_same_v<T, bool>;
+
+    template<typename MemberPtr> struct MemberType;
+    template<typename Msg, typename T> struct MemberType<T Msg::*> {using type = T;};
+
+    template<typename Msg>
+    concept Message = requires
+    {
+        {Msg::TYPE} -> std::convertible_to<MessageType>;
+        Msg::getFields();
+    };
+
+    //The size of Msg once encoded, header included.
+    template<Message Msg>
+    inline constexpr size_t ENCODED_SIZE {std::apply([](auto... fields)
+    {
+        return (HEADER_SIZE + ... + sizeof(typename MemberType<decltype(fields)>::type));
+    }, Msg::getFields())};
+
+    //MOVE_MSGTYPE (see ProtocolCodec.cpp for what the bytes mean).
+    //The server only forwards it, so the fields are left as bytes and checked by toPackedMove().
+    struct MoveMsg
+    {
+        static constexpr MessageType TYPE {MessageType::MOVE_MSGTYPE};
+        uint8_t fromFile, fromRank, toFile, toRank;
+        uint8_t promoType, moveType, rightsToRevoke, wasCapture;
+
+        static constexpr auto getFields()
+        {
+            return std::tuple{&MoveMsg::fromFile, &MoveMsg::fromRank, &MoveMsg::toFile, &MoveMsg::toRank,
+                &MoveMsg::promoType, &MoveMsg::moveType, &MoveMsg::rightsToRevoke, &MoveMsg::wasCapture};
+        }
+    };
+
+    //The header followed by a network byte order uint32_t ID.
+    template<MessageType Type>
+    struct IDMsg
+    {
+        static constexpr MessageType TYPE {Type};
+        uint32_t id;
+
+        static constexpr auto getFields() {return std::tuple{&IDMsg::id};}
+    };
+
+    //The side is left as a byte, like the move fields, and checked by toSide().
+    struct PairingCompleteMsg
+    {
+        static constexpr MessageType TYPE {MessageType::PAIRING_COMPLETE_MSGTYPE};
+        uint8_t side;
+
+        static constexpr auto getFields() {return std::tuple{&PairingCompleteMsg::side};}
+    };
+
+    //A lot of messages have no "payload", but just the two byte header.
+    template<MessageType Type>
+    struct HeaderOnlyMsg
+    {
+        static constexpr MessageType TYPE {Type};
+
+        static constexpr auto getFields() {return std::tuple{};}
+    };
+
+    using PairRequestMsg         = IDMsg<MessageType::PAIR_REQUEST_MSGTYPE>;
+    using PairAcceptMsg          = IDMsg<MessageType::PAIR_ACCEPT_MSGTYPE>;
+    using PairDeclineMsg         = IDMsg<MessageType::PAIR_DECLINE_MSGTYPE>;
+    using IDNotInLobbyMsg        = IDMsg<MessageType::ID_NOT_IN_LOBBY_MSGTYPE>;
+    using NewIDMsg               = IDMsg<MessageType::NEW_ID_MSGTYPE>;
+    using ResignMsg              = HeaderOnlyMsg<MessageType::RESIGN_MSGTYPE>;
+    using DrawOfferMsg           = HeaderOnlyMsg<MessageType::DRAW_OFFER_MSGTYPE>;
+    using DrawAcceptMsg          = HeaderOnlyMsg<MessageType::DRAW_ACCEPT_MSGTYPE>;
+    using DrawDeclineMsg         = HeaderOnlyMsg<MessageType::DRAW_DECLINE_MSGTYPE>;
+    using RematchRequestMsg      = HeaderOnlyMsg<MessageType::REMATCH_REQUEST_MSGTYPE>;
+    using RematchAcceptMsg       = HeaderOnlyMsg<MessageType::REMATCH_ACCEPT_MSGTYPE>;
+    using RematchDeclineMsg      = HeaderOnlyMsg<MessageType::REMATCH_DECLINE_MSGTYPE>;
+    using PairNoResponseMsg      = HeaderOnlyMsg<MessageType::PAIR_NORESPONSE_MSGTYPE>;
+    using ServerFullMsg          = HeaderOnlyMsg<MessageType::SERVER_FULL_MSGTYPE>;
+    using UnpairMsg              = HeaderOnlyMsg<MessageType::UNPAIR_MSGTYPE>;
+    using OpponentClosedConnMsg  = HeaderOnlyMsg<MessageType::OPPONENT_CLOSED_CONNECTION_MSGTYPE>;
+    using PairRequestTooSoonMsg  = HeaderOnlyMsg<MessageType::PAIR_REQUEST_TOO_SOON_MSGTYPE>;
+
+    using AllMessages = std::tuple<MoveMsg, PairingCompleteMsg, PairRequestMsg, PairAcceptMsg, PairDeclineMsg,
+        IDNotInLobbyMsg, NewIDMsg, ResignMsg, DrawOfferMsg, DrawAcceptMsg, DrawDeclineMsg, RematchRequestMsg,
+        RematchAcceptMsg, RematchDeclineMsg, PairNoResponseMsg, ServerFullMsg, UnpairMsg, OpponentClosedConnMsg,
+        PairRequestTooSoonMsg>;
+
+    //Every MessageType has exactly one message struct, and its fields add up to the type's MessageSize.
+    static_assert([]<typename... Msgs>(std::type_identity<std::tuple<Msgs...>>)
+    {
+        std::array<int, 256> numStructs {};
+        (++numStructs[static_cast<size_t>(Msgs::TYPE)], ...);
+
+        for(size_t i = 0; i <= static_cast<size_t>(MessageType::NEW_ID_MSGTYPE); ++i)
+        {
+            if(numStructs[i] != 1)
+                return false;
+        }
+
+        return ((ENCODED_SIZE<Msgs> == getMessageSize(Msgs::TYPE)) && ...);
+    }(std::type_identity<AllMessages>{}), "the message structs don't match chessNetworkProtocol.h");
+
+    namespace Detail
+    {
+        template<Field T>
+        using FieldBits = std::make_unsigned_t<typename std::conditional_t<std::is_enum_v<T>,
+            std::underlying_type<T>, std::type_identity<T>>::type>;
+
+        //most significant byte first (network byte order)
+        template<Field T>
+        constexpr void writeField(std::byte* const out, T const value)
+        {
+            auto const bits {static_cast<FieldBits<T>>(value)};
+            for(size_t i = 0; i < sizeof(bits); ++i)
+                out[i] = static_cast<std::byte>(bits >> (8 * (sizeof(bits) - 1 - i)));
+        }
+
+        template<Field T>
+        constexpr T readField(std::byte const* const in)
+        {
+            FieldBits<T> bits {0};
+            for(size_t i = 0; i < sizeof(bits); ++i)
+                bits = static_cast<FieldBits<T>>((bits << 8) | std::to_integer<FieldBits<T>>(in[i]));
+            return static_cast<T>(bits);
+        }
+    }
+
+    template<Message Msg>
+    using EncodedMessage = std::array<std::byte, ENCODED_SIZE<Msg>>;
+
+    template<Message Msg>
+    constexpr EncodedMessage<Msg> encode(Msg const& msg)
+    {
+        static_assert(ENCODED_SIZE<Msg> == getMessageSize(Msg::TYPE));
+
+        EncodedMessage<Msg> bytes {};
+        bytes[0] = static_cast<std::byte>(Msg::TYPE);
+        bytes[1] = static_cast<std::byte>(ENCODED_SIZE<Msg>);
+
+        std::apply([&](auto... fields)
+        {
+            size_t offset {HEADER_SIZE};
+            ((Detail::writeField(bytes.data() + offset, msg.*fields), offset += sizeof(msg.*fields)), ...);
+        }, Msg::getFields());
+
+        return bytes;
+    }
+
+    //For a message whose header has already been checked (see isValidHeader()), so it is all loads.
+    template<Message Msg>
+    constexpr Msg decodeUnchecked(std::span<std::byte const, ENCODED_SIZE<Msg>> const bytes)
+    {
+        Msg msg {};
+
+        std::apply([&](auto... fields)
+        {
+            size_t offset {HEADER_SIZE};
+            ((msg.*fields = Detail::readField<typename MemberType<decltype(fields)>::type>(bytes.data() + offset),
+                offset += sizeof(msg.*fields)), ...);
+        }, Msg::getFields());
+
+        return msg;
+    }
+
+    //std::nullopt if bytes isn't a Msg (wrong size or header).
+    template<Message Msg>
+    constexpr std::optional<Msg> decode(std::span<std::byte const> const bytes)
+    {
+        if(bytes.size() != ENCODED_SIZE<Msg> ||
+           bytes[0] != static_cast<std::byte>(Msg::TYPE) ||
+           bytes[1] != static_cast<std::byte>(ENCODED_SIZE<Msg>))
+        {
+            return std::nullopt;
+        }
+
+        return decodeUnchecked<Msg>(bytes.template first<ENCODED_SIZE<Msg>>());
+    }
+
+    MoveMsg toMoveMsg(PackedMove move);
+
+    //std::nullopt if msg isn't a well formed move (a square off of the board, an out of
+    //range enum value or a promotion without a piece to promote to).
+    std::optional<PackedMove> toPackedMove(MoveMsg const& msg);
+
+    //std::nullopt if msg's side isn't WHITE or BLACK.
+    std::optional<Side> toSide(PairingCompleteMsg const& msg);
+
+    using MoveMessage = EncodedMessage<MoveMsg>;
+
+    //encode(toMoveMsg(move)) and decode<MoveMsg>() then toPackedMove().
+    MoveMessage encodeMoveMessage(PackedMove move);
+    std::optional<PackedMove> decodeMoveMessage(std::span<std::byte const> msg);
+}
@@ -0,0 +1,55 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <vector>
+
+//A circular buffer of bytes, for data that arrives at one end and is consumed from the other (like a TCP stream).
+//Consuming bytes just moves the read cursor forward, so nothing is ever shifted down and draining n bytes of
+//messages is O(n) no matter how they arrived. The capacity is a power of two so the cursors can count up forever
+//and be wrapped with a mask. Nothing is allocated after construction unless reserve() is called.
+class RingBuffer
+{
+public:
+    //capacity is rounded up to a power of two.
+    explicit RingBuffer(size_t capacity);
+
+    size_t getSize() const {return static_cast<size_t>(mWriteCursor - mReadCursor);}
+    size_t getCapacity() const {return mStorage.size();}
+    size_t getFreeSpace() const {return getCapacity() - getSize();}
+    bool isEmpty() const {return mWriteCursor == mReadCursor;}
+
+    //The free space from the write cursor up to the end of the storage (or up to the read cursor). Fill some of
+    //it (with recv() for example), then commit() however many bytes were written. Empty if the buffer is full.
+    std::span<std::byte> getWritableSpan();
+    void commit(size_t numBytes);
+
+    //Copies bytes in. False (and nothing is copied) if there isn't room for all of them.
+    bool write(std::span<std::byte const> bytes);
+
+    //The byte idx bytes from the read cursor. std::nullopt if there aren't that many bytes in the buffer.
+    std::optional<std::byte> peek(size_t idx) const;
+
+    //A view of the next len bytes without consuming them. It points straight into the buffer unless the bytes
+    //wrap around the end of the storage, in which case they are copied into a scratch buffer first. Either way
+    //the view is only valid until the buffer is next changed. std::nullopt if there aren't len bytes.
+    std::optional<std::span<std::byte const>> view(size_t len);
+
+    //Moves the read cursor len bytes forward (len can't be more than getSize()).
+    void consume(size_t len);
+
+    void clear() {mReadCursor = mWriteCursor = 0;}
+
+    //Grows the capacity to at least capacity (rounded up to a power of two), keeping the bytes in the buffer.
+    //Any span from getWritableSpan() or view() is invalidated if it grows.
+    void reserve(size_t capacity);
+
+private:
+    std::vector<std::byte> mStorage;
+    std::vector<std::byte> mScratch; //where view() puts bytes that wrap around
+    uint64_t mReadCursor {0};
+    uint64_t mWriteCursor {0};
+
+    size_t getMask() const {return mStorage.size() - 1;}
+};
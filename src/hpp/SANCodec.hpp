@@ -0,0 +1,27 @@
+#pragma once
+#include <cstddef>
+#include <optional>
+#include <span>
+#include <string_view>
+
+#include "PackedMove.hpp"
+
+class Board;
+
+//Reads and writes moves in standard algebraic notation (Nbd7, exd5, O-O, e8=Q+ ...) for the side to move on a Board.
+//Both directions work from the legal moves of the position, so the disambiguation is always exactly what is needed.
+//Neither allocates.
+namespace SANCodec
+{
+    //Longer than any SAN move (Qh4xe1# and exd8=Q# are 7).
+    inline constexpr size_t MAX_LENGTH {8};
+
+    //The legal move san describes, std::nullopt if it matches none or more than one of them.
+    //Check/mate marks and annotations (+ # ! ?) are ignored, as is whether a capture has its x.
+    //Castling can be written with O or 0 and a promotion with or without the =.
+    std::optional<PackedMove> parse(Board const&, std::string_view san);
+
+    //Writes move (which must be legal) into out and returns the part of out that was written to.
+    //The board is only changed while move is played to see if it gives check or mate and is left as it was.
+    std::string_view write(Board&, PackedMove move, std::span<char, MAX_LENGTH> out);
+}
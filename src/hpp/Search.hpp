@@ -0,0 +1,113 @@
+#pragma once
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <span>
+#include <stop_token>
+#include <string_view>
+
+#include "HeadlessBoard.hpp"
+#include "PackedMove.hpp"
+#include "MoveList.hpp"
+#include "TranspositionTable.hpp"
+
+struct SearchLimits
+{
+    int maxDepth {64};
+    std::chrono::milliseconds maxTime {std::chrono::milliseconds::max()};
+    uint64_t maxNodes {std::numeric_limits<uint64_t>::max()};
+};
+
+struct SearchResult
+{
+    PackedMove bestMove {}; //the null move if the side to move had no legal moves
+    int score {0};         //centipawns from the point of view of the side to move
+    int depth {0};         //the deepest iteration that was completed
+    uint64_t nodes {0};
+    uint64_t ttProbes {0}; //transposition table lookups, and how many of them found an entry
+    uint64_t ttHits {0};
+    double seconds {0.0};
+};
+
+//Negamax alpha-beta search with iterative deepening and a quiescence search at the leaves.
+//Results are kept in a TranspositionTable (which can be shared with other Searches) so positions reached
+//by different move orders aren't searched again. Moves are ordered by the best move of the previous iteration
+//(at the root) or the transposition table, MVV-LVA for captures, then killer moves and the history heuristic for quiet moves.
+//A Search owns its own Board so it can run on another thread while the Board being shown is left alone.
+class Search
+{
+public:
+    static constexpr int MAX_PLY {128};
+    static constexpr int MATE_SCORE {32000};
+    static constexpr int INFINITE_SCORE {MATE_SCORE + 1};
+
+    //Scores at least this big mean a forced mate was found.
+    static constexpr int MATE_BOUND {MATE_SCORE - MAX_PLY};
+
+    //threadIndex is 0 for a Search running on its own (or the main thread of a LazySMP search).
+    //Helper threads get 1, 2, ... which makes them search in a slightly different order and to
+    //slightly different depths than the main thread, so they fill the shared transposition table with different results.
+    explicit Search(TranspositionTable&, int threadIndex = 0);
+
+    //Sets up the position to search as fen followed by moves. The moves are played
+    //(rather than just setting up the final position) so repetitions of earlier positions are known.
+    void setPosition(std::string_view fen, std::span<PackedMove const> moves);
+
+    //Searches until limits is reached or stopToken is signalled. The result comes from the deepest completed
+    //iteration, so at least a depth 1 search is finished unless the stop is requested before that.
+    //Call TranspositionTable::newSearch() once before starting the Searches sharing the table.
+    SearchResult run(SearchLimits const& limits, std::stop_token stopToken = {});
+
+    Board const& getBoard() const {return mBoard;}
+
+    //Called every time an iteration completes with the result so far (nodes and seconds included),
+    //for tools that want to follow how the best move changes with depth.
+    using IterationCallback = std::function<void(SearchResult const&)>;
+    void setIterationCallback(IterationCallback callback) {mOnIterationComplete = std::move(callback);}
+
+private:
+    HeadlessBoard mBoard;
+
+    TranspositionTable& mTranspositionTable;
+    int const mThreadIndex;
+
+    //One move list (and the ordering score of each move) per ply which gets reused so the search doesn't allocate.
+    std::array<MoveList, MAX_PLY> mPlyMoves;
+    std::array<std::array<int, MoveList::CAPACITY>, MAX_PLY> mPlyMoveScores {};
+
+    //Two quiet moves per ply that caused a beta cutoff in a sibling node.
+    std::array<std::array<PackedMove, 2>, MAX_PLY> mKillers {};
+
+    //How often a quiet move caused a beta cutoff, indexed by [side][source square][destination square].
+    std::array<std::array<std::array<int, 64>, 64>, 3> mHistory {};
+
+    PackedMove mRootBestMove {};
+    IterationCallback mOnIterationComplete;
+    uint64_t mNodes {0};
+    uint64_t mTTProbes {0};
+    uint64_t mTTHits {0};
+    bool mIsStopped {false};
+    SearchLimits mLimits {};
+    std::stop_token mStopToken {};
+    std::chrono::steady_clock::time_point mStartTime {};
+
+    int searchRoot(int depth);
+    int negamax(int depth, int alpha, int beta, int ply);
+    int quiescence(int alpha, int beta, int ply);
+
+    void scoreMoves(int ply, TranspositionTable::Entry const& ttEntry = {});
+    PackedMove pickNextMove(int ply, size_t index);
+    void onQuietMoveCutoff(PackedMove move, int depth, int ply);
+
+    //Checked every so many nodes (the clock is too slow to read at every node).
+    void checkForStop();
+    std::chrono::milliseconds getElapsedTime() const;
+
+public:
+    Search(Search const&)=delete;
+    Search(Search&&)=delete;
+    Search& operator=(Search const&)=delete;
+    Search& operator=(Search&&)=delete;
+};
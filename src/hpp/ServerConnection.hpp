@@ -1,5 +1,6 @@
 #pragma once
-#include <WinSock2.h>
+#include "RingBuffer.hpp"
+#include "Socket.hpp"
 #include <span>
 #include <vector>
 #include <cstddef>
@@ -7,6 +8,7 @@
 #include <string_view>
 #include <future>
 #include <functional>
+#include <chrono>
 
 class ServerConnection
 {
@@ -19,11 +21,16 @@ public:
     //std::nullopt returned when idx is an invalid index.
     std::optional<std::byte> peek(uint32_t idx);
 
-    //Call getDataFromServer() first so that you have the most recent data from the socket.
-    std::optional<std::vector<std::byte>> read(std::size_t len);
+    //Consumes the next len bytes received from the server, returning a view of them.
+    //The view is only valid until the next call to update() or read(). std::nullopt if fewer than len bytes have arrived.
+    //Call update() first so that you have the most recent data from the socket.
+    std::optional<std::span<std::byte const>> read(std::size_t len);
 
-    void write(std::span<std::byte>);
-    auto isConnected() const {return mIsConnected;}
+    void write(std::span<std::byte const>);
+    auto isConnected() const {return mState == State::CONNECTED;}
+
+    //Closes the connection (calling onDisconnect) if there is one, for when what the server sends can't be made sense of.
+    void disconnect();
 
     ServerConnection(std::function<void()> onConnect, std::function<void()> onDisconnect);
     ~ServerConnection();
@@ -31,14 +38,32 @@ public:
 private:
 
     void connectToServerAsync();
-    void disconnect();
+    void connectToNextAddress();
+    void updateConnecting();
+    void receiveFromServer();
+
+    //Every message is at most 255 bytes (its size is one byte), so this holds a good backlog of them.
+    //If a burst fills it anyway it doubles in size, up to s_readBuffMaxCapacity. Past that the
+    //bytes wait in the socket until the messages already here have been read.
+    static constexpr size_t s_readBuffInitialCapacity {4096};
+    static constexpr size_t s_readBuffMaxCapacity {1 << 20};
+    RingBuffer mReadBuff {s_readBuffInitialCapacity};
 
-    static constexpr auto mReadBuffInitialSize {256};
-    std::vector<char> mReadBuff;
+    //The server's address is looked up on another thread (getaddrinfo() blocks), then each address it
+    //resolves to is tried in turn with a non-blocking connect that update() checks on every frame.
+    enum struct State {RESOLVING, CONNECTING, CONNECTED, DISCONNECTED};
+    State mState {State::DISCONNECTED};
 
-    std::future<std::optional<SOCKET>> mFutureSocket;
-    SOCKET mSocket {INVALID_SOCKET};
-    WSADATA mWinSockData {};
+    std::future<std::vector<Socket::Address>> mFutureAddresses;
+    std::vector<Socket::Address> mAddresses;
+    size_t mNextAddress {0};
+
+    Socket mSocket;
+    std::chrono::steady_clock::time_point mConnectStartTime;
+    static constexpr std::chrono::seconds s_connectTimeout {5};
+
+    //How long write() will wait for room in the socket's send buffer before giving up on the connection.
+    static constexpr int s_sendTimeoutMS {1000};
 
     //If ServerIP.txt could not be found or there was some IO error with it,
     //then a new one is made. These will be the default port and ip values written to it.
@@ -46,9 +71,6 @@ private:
     std::string const mDefaultServerIpStr   {"127.0.0.1"};
     std::string const mServerAddrFileName   {"ServerIP.txt"};
 
-    bool mIsConnected {false};
-    bool mConnectToServerThreadIsDone {false};
-
     std::function<void()> mOnConnect;
     std::function<void()> mOnDisconnect;
 
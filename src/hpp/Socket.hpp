@@ -0,0 +1,70 @@
+#pragma once
+#include <cstddef>
+#include <expected>
+#include <span>
+#include <string>
+#include <vector>
+#include <sys/socket.h>
+
+//A non-blocking TCP socket (POSIX). ServerConnection is written against this class rather than the socket API
+//itself, so nothing above it has to know what a file descriptor or errno is. Every socket is made non-blocking
+//with Nagle's algorithm turned off (TCP_NODELAY), since the chess messages are tiny and should go out right away.
+class Socket
+{
+public:
+
+    //One address getaddrinfo() came up with for a host and port.
+    struct Address
+    {
+        sockaddr_storage storage {};
+        socklen_t length {0};
+        int family {AF_UNSPEC};
+    };
+
+    //Blocks while the host name is looked up, so call it off of the main thread.
+    //The error says why the host and port couldn't be resolved.
+    static std::expected<std::vector<Address>, std::string> resolve(std::string const& host, std::string const& port);
+
+    //Starts connecting to address without waiting for the connection to be made (see pollConnect()).
+    static std::expected<Socket, std::string> startConnect(Address const&);
+
+    enum struct Error
+    {
+        WOULD_BLOCK, //nothing could be sent/received right now without blocking
+        CLOSED,      //the other end closed the connection
+        FAILED       //the error has already been logged
+    };
+
+    //True once a connect started with startConnect() has gone through, false if it is still going.
+    //The error says why the connect failed.
+    std::expected<bool, std::string> pollConnect() const;
+
+    //Waits up to timeoutMS (0 to just check) for there to be something to receive/room to send.
+    std::expected<bool, Error> pollReadable(int timeoutMS = 0) const;
+    std::expected<bool, Error> pollWritable(int timeoutMS = 0) const;
+
+    //The number of bytes received into/sent from the buffer, which is never 0.
+    std::expected<size_t, Error> receive(std::span<std::byte> buffer);
+    std::expected<size_t, Error> send(std::span<std::byte const> buffer);
+
+    bool isOpen() const {return mFD != INVALID_FD;}
+    void close();
+
+    Socket()=default;
+    Socket(Socket&&) noexcept;
+    Socket& operator=(Socket&&) noexcept;
+    ~Socket();
+
+private:
+
+    static constexpr int INVALID_FD {-1};
+    int mFD {INVALID_FD};
+
+    explicit Socket(int fd) : mFD{fd} {}
+
+    std::expected<bool, Error> poll(short events, int timeoutMS) const;
+
+public:
+    Socket(Socket const&)=delete;
+    Socket& operator=(Socket const&)=delete;
+};
@@ -0,0 +1,13 @@
+#pragma once
+#include <string_view>
+
+//FEN strings for positions that are handy when testing the rules.
+//The board can be started from any of them (see startingFEN in Board.cpp)
+//and chess_perft checks them against known node counts.
+namespace TestPositions
+{
+    inline constexpr std::string_view defaultPositionFEN       {"rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1"};
+    inline constexpr std::string_view stalemateTestPositionFEN {"7k/8/8/8/8/8/6q1/K7 b - - 0 1"};
+    inline constexpr std::string_view promotionTestPositionFEN {"rnbqkbnr/ppPppppp/8/8/8/8/PPPPPPpP/RNBQKBNR w KQkq - 0 1"};
+    inline constexpr std::string_view castleTestPositionFEN    {"r3k2r/pppppppp/8/8/8/8/PPPPPPPP/R3K2R w KQkq - 0 1"};
+}
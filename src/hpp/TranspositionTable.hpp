@@ -0,0 +1,85 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+
+#include "PackedMove.hpp"
+
+//A fixed size hash table of search results keyed by the Zobrist hash of the position (Board::getHash()).
+//
+//It is shared by every search thread without any locks. Each entry is two 64 bit words: the data and
+//the hash XORed with the data. If two threads write the same entry at the same time the words can end up
+//from different writes, but then the hash worked out from them won't match and the entry is just a miss.
+//The words are relaxed atomics so this isn't a data race as far as C++ is concerned (they compile to plain loads/stores).
+//
+//Entries are grouped 4 to a 64 byte bucket (one cache line), so a probe only ever touches one cache line.
+class TranspositionTable
+{
+public:
+    //How the stored score relates to the real score of the position.
+    enum struct Bound : uint8_t {NONE = 0, EXACT, LOWER, UPPER};
+
+    struct Entry
+    {
+        PackedMove move {}; //the best move (or the move that caused a cutoff), the null move if there wasn't one
+        int score {0};
+        int depth {0};
+        Bound bound {Bound::NONE};
+    };
+
+    explicit TranspositionTable(size_t sizeInMB);
+
+    //Throws away the current table and allocates a new empty one. Must not be called while a search is using the table.
+    void resize(size_t sizeInMB);
+    void clear();
+
+    //Call at the start of every search. Entries from older searches are replaced before ones from the current search.
+    void newSearch() {mAge = static_cast<uint8_t>(mAge + 1);}
+
+    //Doesn't count anything itself (a shared counter would bounce a cache line between every search thread
+    //on every node), so hit rates are counted by each Search (see SearchResult::ttProbes).
+    std::optional<Entry> probe(uint64_t hash) const;
+    void store(uint64_t hash, Entry const& entry);
+
+    size_t getSizeInMB() const {return mNumBuckets * sizeof(Bucket) / (1024 * 1024);}
+
+    //How full the table is in permill, from a sample of the first 1000 buckets. Only entries from the current search count.
+    int getPermillFull() const;
+
+private:
+    struct alignas(64) Bucket
+    {
+        struct Slot
+        {
+            std::atomic<uint64_t> hashXorData {0};
+            std::atomic<uint64_t> data {0};
+        };
+
+        std::array<Slot, 4> slots;
+    };
+
+    static_assert(sizeof(Bucket) == 64, "a bucket should fill exactly one cache line");
+
+    std::unique_ptr<Bucket[]> mBuckets;
+    size_t mNumBuckets {0}; //always a power of 2 so the bucket of a hash is just its low bits
+    uint8_t mAge {0};
+
+    Bucket& getBucket(uint64_t hash) const {return mBuckets[hash & (mNumBuckets - 1)];}
+
+    //The data word layout (from the low bit): the move as a PackedMove (16 bits, zero if there is none),
+    //score (16 bits), depth (8 bits), bound (2 bits), age (8 bits).
+    uint64_t pack(Entry const& entry) const;
+    static Entry unpack(uint64_t data);
+    static Bound getBound(uint64_t data) {return static_cast<Bound>((data >> 40) & 0b11);}
+    static int getDepth(uint64_t data) {return static_cast<int>((data >> 32) & 0xFF);}
+    static uint8_t getAge(uint64_t data) {return static_cast<uint8_t>(data >> 42);}
+
+public:
+    TranspositionTable(TranspositionTable const&)=delete;
+    TranspositionTable(TranspositionTable&&)=delete;
+    TranspositionTable& operator=(TranspositionTable const&)=delete;
+    TranspositionTable& operator=(TranspositionTable&&)=delete;
+};
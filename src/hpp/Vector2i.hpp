@@ -1,6 +1,5 @@
 #pragma once
 #include <iostream>
-#include "imgui.h"
 
 //inline vector2 struct used for chess positions (0-7)
 struct Vec2i
@@ -9,16 +8,13 @@ struct Vec2i
 
     constexpr Vec2i() = default;
     constexpr Vec2i(int x_, int y_) : x{x_}, y{y_} {}
-    constexpr Vec2i(ImVec2 imVec2) : x{static_cast<int>(imVec2.x)}, y{static_cast<int>(imVec2.y)} {}
 
     //Defaulted c++20 spaceship operator allows compiler 
     //to supply default comparison operators for this struct.
     auto operator<=>(Vec2i const&) const = default;
 
-    inline operator ImVec2() const
-    {
-        return ImVec2(static_cast<float>(x), static_cast<float>(y));
-    }
+    //The conversions to and from ImVec2 live in ImGuiConfig.hpp so that
+    //this header (and the chess rules code using it) doesn't depend on ImGui.
 
     friend std::ostream& operator<<(std::ostream& os, Vec2i const& v)
     {
@@ -0,0 +1,54 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <cstddef>
+#include "Bitboard.hpp"
+#include "PieceCode.hpp"
+
+//Random keys for Zobrist hashing. The hash of a position is the XOR of the key of every piece on its square,
+//the black to move key when it is black's turn, the key for the castle rights and the key for the en passant file.
+//Since XOR undoes itself, a move only has to XOR out/in the keys that changed instead of hashing the whole board again.
+//The keys are generated at compile time from a fixed seed, so a hash means the same thing in every build and every run.
+namespace Zobrist
+{
+    inline constexpr size_t NUM_PIECE_KEYS      {12 * 64}; //6 piece types for each side on every square
+    inline constexpr size_t BLACK_TO_MOVE_INDEX {NUM_PIECE_KEYS};
+    inline constexpr size_t CASTLE_RIGHTS_INDEX {BLACK_TO_MOVE_INDEX + 1}; //16 keys (one for every combination of the 4 rights)
+    inline constexpr size_t EN_PASSANT_INDEX    {CASTLE_RIGHTS_INDEX + 16}; //8 keys (one per file)
+    inline constexpr size_t NUM_KEYS            {EN_PASSANT_INDEX + 8};
+
+    //splitmix64
+    inline constexpr auto s_keys = []
+    {
+        std::array<uint64_t, NUM_KEYS> keys {};
+        uint64_t state {0x5A0B'1257'C0FF'EE42ull};
+
+        for(auto& key : keys)
+        {
+            uint64_t z {state += 0x9E37'79B9'7F4A'7C15ull};
+            z = (z ^ (z >> 30)) * 0xBF58'476D'1CE4'E5B9ull;
+            z = (z ^ (z >> 27)) * 0x94D0'49BB'1331'11EBull;
+            key = z ^ (z >> 31);
+        }
+
+        return keys;
+    }();
+
+    //code must not be an empty square.
+    constexpr uint64_t getPieceKey(PieceCode const code, Square const sq)
+    {
+        auto const sideIdx {static_cast<size_t>(code.getSide()) - 1};
+        auto const typeIdx {static_cast<size_t>(code.getType()) - 1};
+        return s_keys[(sideIdx * 6 + typeIdx) * 64 + static_cast<size_t>(sq)];
+    }
+
+    constexpr uint64_t getBlackToMoveKey() {return s_keys[BLACK_TO_MOVE_INDEX];}
+
+    //rightsBits is CastleRights::getRights().
+    constexpr uint64_t getCastleRightsKey(unsigned char const rightsBits)
+    {
+        return s_keys[CASTLE_RIGHTS_INDEX + (rightsBits & 0b1111)];
+    }
+
+    constexpr uint64_t getEnPassantKey(int const file) {return s_keys[EN_PASSANT_INDEX + static_cast<size_t>(file)];}
+}
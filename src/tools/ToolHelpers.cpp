@@ -0,0 +1,58 @@
+#include "ToolHelpers.hpp"
+#include "HeadlessBoard.hpp"
+#include "MoveList.hpp"
+#include "TestPositions.hpp"
+
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+
+int printUsage(std::string_view const usage)
+{
+    std::cerr << "usage:\n" << usage;
+    return EXIT_FAILURE;
+}
+
+void playRandomGame(Board& board, std::mt19937& rng, int const maxPlies)
+{
+    board.setPosition(TestPositions::defaultPositionFEN);
+
+    MoveList moves;
+    for(int ply = 0; ply < maxPlies; ++ply)
+    {
+        board.generateLegalMoves(moves);
+        if(moves.empty())
+            break;
+
+        board.makeMove(moves[std::uniform_int_distribution<size_t>{0, moves.size() - 1}(rng)]);
+    }
+}
+
+int generateGames(char const* const path, int const numGames, unsigned const seed,
+    std::function<void(std::ostream&, Board const&)> const& writeGame)
+{
+    std::ofstream file {path, std::ios::binary};
+    if( ! file )
+    {
+        std::cerr << "could not open " << path << '\n';
+        return EXIT_FAILURE;
+    }
+
+    HeadlessBoard board;
+    std::mt19937 rng {seed};
+
+    for(int i = 0; i < numGames; ++i)
+    {
+        playRandomGame(board, rng);
+        writeGame(file, board);
+    }
+
+    if( ! file.flush() )
+    {
+        std::cerr << "could not write " << path << '\n';
+        return EXIT_FAILURE;
+    }
+
+    std::cout << "wrote " << numGames << " games to " << path << '\n';
+    return EXIT_SUCCESS;
+}
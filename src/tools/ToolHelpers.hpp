@@ -0,0 +1,37 @@
+#pragma once
+#include <charconv>
+#include <concepts>
+#include <functional>
+#include <optional>
+#include <ostream>
+#include <random>
+#include <string_view>
+
+#include "Board.hpp"
+
+//What the headless tools in src/tools have in common.
+
+//A whole number of at least 1 (a depth, a thread count, a number of games ...), std::nullopt if str is anything else.
+template<std::integral T = int>
+std::optional<T> parsePositiveInt(std::string_view const str)
+{
+    T value {0};
+    auto const [ptr, ec] {std::from_chars(str.data(), str.data() + str.size(), value)};
+    if(ec != std::errc{} || ptr != str.data() + str.size() || value < 1)
+        return std::nullopt;
+    return value;
+}
+
+//Prints "usage:" and then usage (one indented line per command) to std::cerr. Returns EXIT_FAILURE so a tool
+//can return it straight from main().
+int printUsage(std::string_view usage);
+
+//Sets up the start position on board and plays up to maxPlies random legal moves from it (fewer if the game ends
+//in mate or stalemate). The moves played are board.getMoveHistory().
+void playRandomGame(Board& board, std::mt19937& rng, int maxPlies = 200);
+
+//The `generate <file> <games> [seed]` command of the tools that read games. Plays numGames random games
+//(see playRandomGame()) and calls writeGame with the board each one was played on to write it to the file at path.
+//Returns EXIT_SUCCESS once they are all written, printing how many there were.
+int generateGames(char const* path, int numGames, unsigned seed,
+    std::function<void(std::ostream&, Board const&)> const& writeGame);
@@ -0,0 +1,243 @@
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <charconv>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include "FENCodec.hpp"
+#include "GameArchive.hpp"
+#include "MoveGen.hpp"
+#include "PGN.hpp"
+#include "Position.hpp"
+#include "ToolHelpers.hpp"
+
+//Headless tool for binary game archives (see GameArchive.hpp). Converts PGN databases into archives, prints any game
+//of an archive as PGN (found through the index without reading the games before it) and scans every position of
+//every game in an archive to gather statistics, reporting how many positions per second were scanned.
+//
+//usage:
+//  chess_archive import <pgn file> <archive>   adds the games of a PGN file (the ones without errors) to archive
+//  chess_archive get <archive> <game>          prints the game at index game (from 0) as PGN
+//  chess_archive scan <archive>                plays through every game, counting positions, captures, checks ...
+
+static constexpr std::string_view USAGE
+{
+    "  chess_archive import <pgn file> <archive>  add the games of a PGN file to archive\n"
+    "  chess_archive get <archive> <game>         print the game at index game (from 0) as PGN\n"
+    "  chess_archive scan <archive>               play through every game of archive gathering statistics\n"
+};
+
+static int importPGN(char const* const pgnPath, char const* const archivePath)
+{
+    std::ifstream pgnFile {pgnPath, std::ios::binary};
+    if( ! pgnFile )
+    {
+        std::cerr << "could not open " << pgnPath << '\n';
+        return EXIT_FAILURE;
+    }
+
+    GameArchive::Writer writer {archivePath};
+    if( ! writer.isOpen() )
+    {
+        std::cerr << "could not open " << archivePath << " (or it isn't a game archive)\n";
+        return EXIT_FAILURE;
+    }
+
+    auto const importTime {std::chrono::duration_cast<std::chrono::seconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count()};
+
+    PGNReader reader {pgnFile};
+    PGNGame game;
+    uint64_t numImported {0};
+    uint64_t numSkipped {0};
+
+    while(reader.readGame(game))
+    {
+        if(game.error)
+        {
+            ++numSkipped;
+            continue;
+        }
+
+        bool const isStartPosition {game.startingFEN == TestPositions::defaultPositionFEN};
+        if( ! writer.append(isStartPosition ? std::string_view{} : game.startingFEN, game.moves,
+            GameArchive::toResult(game.result), importTime) )
+        {
+            std::cerr << "could not write to " << archivePath << '\n';
+            return EXIT_FAILURE;
+        }
+
+        ++numImported;
+    }
+
+    std::cout << "imported " << numImported << " games  skipped " << numSkipped << " with errors\n";
+    return EXIT_SUCCESS;
+}
+
+static int printGame(GameArchive::Reader const& archive, std::string_view const gameIndexArg)
+{
+    size_t gameIndex {0};
+    auto const [ptr, ec] {std::from_chars(gameIndexArg.data(), gameIndexArg.data() + gameIndexArg.size(), gameIndex)};
+    if(ec != std::errc{} || ptr != gameIndexArg.data() + gameIndexArg.size() || gameIndex >= archive.getNumGames())
+    {
+        std::cerr << "there is no game " << gameIndexArg << " (the archive has " << archive.getNumGames() << " games)\n";
+        return EXIT_FAILURE;
+    }
+
+    auto const game {archive.getGame(gameIndex)};
+    if( ! game )
+    {
+        std::cerr << "game " << gameIndex << " is damaged\n";
+        return EXIT_FAILURE;
+    }
+
+    PGNGame pgnGame;
+    pgnGame.setTag("Round", std::to_string(gameIndex));
+    if( ! game->startingFEN.empty() )
+        pgnGame.startingFEN = game->startingFEN;
+    pgnGame.moves.assign(game->moves.begin(), game->moves.end());
+    pgnGame.result = GameArchive::toPGNResult(game->result);
+
+    PGNWriter writer;
+    writer.write(std::cout, pgnGame);
+    return EXIT_SUCCESS;
+}
+
+static PieceTypes toPieceType(ChessMove::PromoTypes const promoType)
+{
+    switch(promoType)
+    {
+    case ChessMove::PromoTypes::ROOK:   return PieceTypes::ROOK;
+    case ChessMove::PromoTypes::KNIGHT: return PieceTypes::KNIGHT;
+    case ChessMove::PromoTypes::BISHOP: return PieceTypes::BISHOP;
+    default:                            return PieceTypes::QUEEN;
+    }
+}
+
+//Plays move on pos, which is all a scan needs (no castle rights, clocks or hashes to keep up to date like Board::makeMove()).
+//False if there isn't a piece of side's on the square the move is from, which means the move can't be from this game.
+static bool playMove(Position& pos, PackedMove const move, Side const side)
+{
+    Square const from {move.getFrom()};
+    Square const to {move.getTo()};
+    if(pos.pieceAt(from).isEmpty() || pos.pieceAt(from).getSide() != side)
+        return false;
+
+    Square const capturedAt {move.isEnPassant() ? (from & ~7) | (to & 7) : to};
+    if(pos.pieceAt(capturedAt))
+        pos.removePiece(capturedAt);
+
+    pos.movePiece(from, to);
+
+    if(move.isCastle())
+    {
+        bool const isLongCastle {to < from};
+        pos.movePiece(isLongCastle ? to - 2 : to + 1, isLongCastle ? to + 1 : to - 1);
+    }
+    else if(move.isPromotion())
+    {
+        pos.removePiece(to);
+        pos.putPiece(to, PieceCode{side, toPieceType(move.getPromoType())});
+    }
+
+    return true;
+}
+
+static int scanArchive(GameArchive::Reader const& archive)
+{
+    auto const startPosition {FENCodec::parse(TestPositions::defaultPositionFEN)};
+
+    uint64_t numPositions {0};
+    uint64_t numCaptures {0};
+    uint64_t numChecks {0};
+    uint64_t numCastles {0};
+    uint64_t numPromotions {0};
+    uint64_t numDamaged {0};
+    size_t longestGame {0};
+    std::array<uint64_t, 4> numResults {}; //indexed by GameArchive::Result
+
+    archive.adviseSequential();
+    auto const start {std::chrono::steady_clock::now()};
+
+    for(size_t i = 0; i < archive.getNumGames(); ++i)
+    {
+        auto const game {archive.getGame(i)};
+        auto const fen {game && ! game->startingFEN.empty() ? FENCodec::parse(game->startingFEN) : startPosition};
+        if( ! game || ! fen )
+        {
+            ++numDamaged;
+            continue;
+        }
+
+        Position pos {fen->position};
+        Side side {fen->sideToMove};
+        ++numPositions;
+        ++numResults[static_cast<size_t>(game->result) & 3];
+        longestGame = std::max(longestGame, game->moves.size());
+
+        for(auto const move : game->moves)
+        {
+            if( ! playMove(pos, move, side) )
+            {
+                ++numDamaged;
+                break;
+            }
+
+            side = side == Side::WHITE ? Side::BLACK : Side::WHITE;
+            ++numPositions;
+            numCaptures += move.isCapture();
+            numCastles += move.isCastle();
+            numPromotions += move.isPromotion();
+
+            Side const opponent {side == Side::WHITE ? Side::BLACK : Side::WHITE};
+            numChecks += MoveGen::getAttackersTo(pos, pos.getKingSquare(side), opponent, pos.getOccupied()) != 0;
+        }
+    }
+
+    std::chrono::duration<double> const elapsed {std::chrono::steady_clock::now() - start};
+    double const seconds {elapsed.count()};
+    using enum GameArchive::Result;
+
+    std::cout << "games " << archive.getNumGames() << "  damaged " << numDamaged << "  positions " << numPositions
+        << "  longest " << longestGame << " plies\n"
+        << "1-0 " << numResults[static_cast<size_t>(WHITE_WINS)] << "  0-1 " << numResults[static_cast<size_t>(BLACK_WINS)]
+        << "  1/2-1/2 " << numResults[static_cast<size_t>(DRAW)] << "  * " << numResults[static_cast<size_t>(UNKNOWN)] << '\n'
+        << "captures " << numCaptures << "  checks " << numChecks << "  castles " << numCastles
+        << "  promotions " << numPromotions << '\n'
+        << "time " << static_cast<uint64_t>(seconds * 1000.0) << "ms  positions/s "
+        << (seconds > 0.0 ? static_cast<uint64_t>(numPositions / seconds) : 0) << '\n';
+
+    return numDamaged == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+int main(int argumentCount, char** argumentVector)
+{
+    if(argumentCount < 3)
+        return printUsage(USAGE);
+
+    std::string_view const command {argumentVector[1]};
+
+    if(command == "import")
+        return argumentCount < 4 ? printUsage(USAGE) : importPGN(argumentVector[2], argumentVector[3]);
+
+    if(command != "get" && command != "scan")
+        return printUsage(USAGE);
+
+    auto const archive {GameArchive::Reader::open(argumentVector[2])};
+    if( ! archive )
+    {
+        std::cerr << archive.error() << '\n';
+        return EXIT_FAILURE;
+    }
+
+    if(command == "get")
+        return argumentCount < 4 ? printUsage(USAGE) : printGame(*archive, argumentVector[3]);
+
+    return scanArchive(*archive);
+}
@@ -0,0 +1,296 @@
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "FENCodec.hpp"
+#include "HeadlessBoard.hpp"
+#include "SANCodec.hpp"
+#include "Search.hpp"
+#include "ToolHelpers.hpp"
+#include "TranspositionTable.hpp"
+
+//Headless EPD test suite runner for tracking the engine's strength across builds. Every position of an EPD file
+//is searched with the same time or node budget and checked against its bm (best move) and am (avoid move) operations.
+//A single thread is used and the transposition table is cleared between positions, so a node budget gives the
+//same results on every run. The output is JSON lines: one object per position and then a summary object.
+//
+//usage:
+//  chess_epd <file> time <ms> [hashMB]     searches each position for ms milliseconds
+//  chess_epd <file> nodes <n> [hashMB]     searches each position for about n nodes
+
+//One line of an EPD file: the first four FEN fields followed by operations like  bm Qxf7+; id "WAC.001";
+struct EPDRecord
+{
+    std::string fen;
+    std::string id;
+    std::vector<std::string> bestMoves;
+    std::vector<std::string> avoidMoves;
+};
+
+//Splits s into the space separated tokens of an operation, keeping a quoted string (without its quotes) as one token.
+static std::vector<std::string_view> tokenize(std::string_view s)
+{
+    std::vector<std::string_view> tokens;
+    while(true)
+    {
+        auto const start {s.find_first_not_of(' ')};
+        if(start == std::string_view::npos)
+            break;
+        s.remove_prefix(start);
+
+        if(s.front() == '"')
+        {
+            auto const end {s.find('"', 1)};
+            tokens.push_back(s.substr(1, end == std::string_view::npos ? std::string_view::npos : end - 1));
+            s.remove_prefix(end == std::string_view::npos ? s.size() : end + 1);
+        }
+        else
+        {
+            auto const end {std::min(s.find(' '), s.size())};
+            tokens.push_back(s.substr(0, end));
+            s.remove_prefix(end);
+        }
+    }
+    return tokens;
+}
+
+static std::optional<EPDRecord> parseEPDLine(std::string_view line)
+{
+    EPDRecord record;
+
+    //the first four fields are the position
+    size_t fieldsEnd {0};
+    for(int field = 0; field < 4; ++field)
+    {
+        fieldsEnd = line.find_first_not_of(' ', fieldsEnd);
+        if(fieldsEnd == std::string_view::npos)
+            return std::nullopt;
+        fieldsEnd = std::min(line.find(' ', fieldsEnd), line.size());
+    }
+    record.fen = line.substr(0, fieldsEnd);
+    line.remove_prefix(fieldsEnd);
+
+    //the operations are separated by semicolons, which can't be inside a quoted string
+    bool isInQuotes {false};
+    size_t opStart {0};
+    for(size_t i = 0; i <= line.size(); ++i)
+    {
+        if(i < line.size() && line[i] == '"')
+            isInQuotes = ! isInQuotes;
+
+        if(i < line.size() && (line[i] != ';' || isInQuotes))
+            continue;
+
+        auto const tokens {tokenize(line.substr(opStart, i - opStart))};
+        opStart = i + 1;
+        if(tokens.empty())
+            continue;
+
+        if(tokens[0] == "id" && tokens.size() > 1)
+            record.id = tokens[1];
+        else if(tokens[0] == "bm")
+            record.bestMoves.assign(tokens.begin() + 1, tokens.end());
+        else if(tokens[0] == "am")
+            record.avoidMoves.assign(tokens.begin() + 1, tokens.end());
+    }
+
+    return record;
+}
+
+static std::string toJSONString(std::string_view const s)
+{
+    std::string out {"\""};
+    for(char const c : s)
+    {
+        if(c == '"' || c == '\\')
+            out.push_back('\\');
+        out.push_back(c);
+    }
+    return out.append("\"");
+}
+
+static std::string toJSONArray(std::vector<std::string> const& strings)
+{
+    std::string out {"["};
+    for(size_t i = 0; i < strings.size(); ++i)
+        out.append(i ? "," : "").append(toJSONString(strings[i]));
+    return out.append("]");
+}
+
+static constexpr std::string_view USAGE
+{
+    "  chess_epd <file> time <ms> [hashMB]   search each position for ms milliseconds\n"
+    "  chess_epd <file> nodes <n> [hashMB]   search each position for about n nodes\n"
+};
+
+int main(int argumentCount, char** argumentVector)
+{
+    if(argumentCount < 4)
+        return printUsage(USAGE);
+
+    std::string_view const budgetType {argumentVector[2]};
+    auto const budget {parsePositiveInt<uint64_t>(argumentVector[3])};
+    auto const hashSizeMB
+    {
+        argumentCount > 4 ? parsePositiveInt<uint64_t>(argumentVector[4]) : std::optional<uint64_t>{64}
+    };
+    if( ! budget || ! hashSizeMB || (budgetType != "time" && budgetType != "nodes"))
+        return printUsage(USAGE);
+
+    SearchLimits limits;
+    if(budgetType == "time")
+        limits.maxTime = std::chrono::milliseconds{*budget};
+    else
+        limits.maxNodes = *budget;
+
+    std::ifstream file {argumentVector[1]};
+    if( ! file )
+    {
+        std::cerr << "could not open " << argumentVector[1] << '\n';
+        return EXIT_FAILURE;
+    }
+
+    TranspositionTable transpositionTable {*hashSizeMB};
+    Search search {transpositionTable};
+
+    //SANCodec::write() needs a Board it can play the best move on
+    HeadlessBoard sanBoard;
+
+    //the first iteration after which the best move was right and stayed right
+    std::optional<double> solvedAtSeconds;
+    bool isSolved {false};
+    std::vector<PackedMove> bestMoves;
+    std::vector<PackedMove> avoidMoves;
+
+    auto const solves = [&](PackedMove const move)
+    {
+        return (bestMoves.empty() || std::ranges::find(bestMoves, move) != bestMoves.end()) &&
+            std::ranges::find(avoidMoves, move) == avoidMoves.end();
+    };
+
+    search.setIterationCallback([&](SearchResult const& result)
+    {
+        isSolved = solves(result.bestMove);
+        if( ! isSolved )
+            solvedAtSeconds.reset();
+        else if( ! solvedAtSeconds )
+            solvedAtSeconds = result.seconds;
+    });
+
+    int numPositions {0};
+    int numSolved {0};
+    int numSkipped {0};
+    double totalSolveSeconds {0.0};
+    double totalSeconds {0.0};
+    uint64_t totalNodes {0};
+
+    std::string line;
+    for(int lineNumber = 1; std::getline(file, line); ++lineNumber)
+    {
+        if( ! line.empty() && line.back() == '\r')
+            line.pop_back();
+        if(line.find_first_not_of(' ') == std::string::npos || line.front() == '#')
+            continue;
+
+        auto const skip = [&](std::string_view const error)
+        {
+            ++numSkipped;
+            std::cout << "{\"line\":" << lineNumber << ",\"error\":" << toJSONString(error) << "}\n";
+        };
+
+        auto const record {parseEPDLine(line)};
+        if( ! record )
+        {
+            skip("fewer than 4 position fields");
+            continue;
+        }
+
+        auto const fen {FENCodec::parse(record->fen)};
+        if( ! fen )
+        {
+            skip(fen.error().message);
+            continue;
+        }
+
+        search.setPosition(record->fen, {});
+
+        //the moves are matched against the legal moves, so a bm that doesn't parse means a broken record
+        auto const toMoves = [&](std::vector<std::string> const& sans, std::vector<PackedMove>& moves)
+        {
+            moves.clear();
+            for(auto const& san : sans)
+            {
+                auto const move {SANCodec::parse(search.getBoard(), san)};
+                if( ! move )
+                    return false;
+                moves.push_back(*move);
+            }
+            return true;
+        };
+
+        if( ! toMoves(record->bestMoves, bestMoves) || ! toMoves(record->avoidMoves, avoidMoves))
+        {
+            skip("bm or am move isn't legal in the position");
+            continue;
+        }
+
+        if(bestMoves.empty() && avoidMoves.empty())
+        {
+            skip("no bm or am operation");
+            continue;
+        }
+
+        transpositionTable.clear();
+        transpositionTable.newSearch();
+        solvedAtSeconds.reset();
+        isSolved = false;
+
+        auto const result {search.run(limits)};
+
+        std::string moveSAN {"none"};
+        if(result.bestMove)
+        {
+            (void)sanBoard.setPosition(record->fen);
+
+            std::array<char, SANCodec::MAX_LENGTH> buffer;
+            moveSAN = SANCodec::write(sanBoard, result.bestMove, buffer);
+        }
+
+        ++numPositions;
+        totalNodes += result.nodes;
+        totalSeconds += result.seconds;
+        if(isSolved)
+        {
+            ++numSolved;
+            totalSolveSeconds += *solvedAtSeconds;
+        }
+
+        std::cout << "{\"line\":" << lineNumber << ",\"id\":" << toJSONString(record->id)
+            << ",\"solved\":" << (isSolved ? "true" : "false") << ",\"move\":" << toJSONString(moveSAN)
+            << ",\"bm\":" << toJSONArray(record->bestMoves) << ",\"am\":" << toJSONArray(record->avoidMoves)
+            << ",\"score\":" << result.score << ",\"depth\":" << result.depth << ",\"nodes\":" << result.nodes
+            << ",\"ms\":" << static_cast<uint64_t>(result.seconds * 1000.0)
+            << ",\"solved_ms\":";
+
+        if(isSolved) std::cout << static_cast<uint64_t>(*solvedAtSeconds * 1000.0);
+        else std::cout << "null";
+
+        std::cout << "}\n";
+    }
+
+    std::cout << "{\"summary\":true,\"positions\":" << numPositions << ",\"solved\":" << numSolved
+        << ",\"skipped\":" << numSkipped << ",\"budget\":" << toJSONString(budgetType) << ",\"budget_value\":" << *budget
+        << ",\"avg_solved_ms\":" << (numSolved ? totalSolveSeconds * 1000.0 / numSolved : 0.0)
+        << ",\"nodes\":" << totalNodes << ",\"ms\":" << static_cast<uint64_t>(totalSeconds * 1000.0)
+        << ",\"nps\":" << (totalSeconds > 0.0 ? static_cast<uint64_t>(totalNodes / totalSeconds) : 0) << "}\n";
+
+    return EXIT_SUCCESS;
+}
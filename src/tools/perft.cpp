@@ -0,0 +1,220 @@
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Board.hpp"
+#include "FENCodec.hpp"
+#include "HeadlessBoard.hpp"
+#include "MoveList.hpp"
+#include "TestPositions.hpp"
+#include "ToolHelpers.hpp"
+
+//Headless perft (performance test) tool. Counts every leaf node of the legal move tree
+//down to a given depth using Board::makeMove()/unmakeMove() and reports the nodes per second.
+//Comparing the counts against known values catches move generation bugs, and the nps catches slowdowns.
+//
+//usage:
+//  chess_perft                        runs every reference position and checks the node counts
+//  chess_perft suite <maxDepth>       same as above but stops each position at maxDepth
+//  chess_perft perft <depth> [FEN]    counts the nodes from FEN (the start position if no FEN is given)
+//  chess_perft divide <depth> [FEN]   same as perft but also prints the nodes below each root move
+
+struct ReferencePosition
+{
+    std::string_view name;
+    std::string_view fen;
+    std::vector<uint64_t> nodes; //nodes[i] is the node count at depth i + 1
+};
+
+//Well known perft results (https://www.chessprogramming.org/Perft_Results) plus the test positions from Board.cpp.
+static std::vector<ReferencePosition> const s_referencePositions
+{
+    {"start position", TestPositions::defaultPositionFEN, {20, 400, 8902, 197281, 4865609}},
+    {"kiwipete", "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1", {48, 2039, 97862, 4085603}},
+    {"position 3", "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1", {14, 191, 2812, 43238, 674624}},
+    {"position 4", "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1", {6, 264, 9467, 422333}},
+    {"position 5", "rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8", {44, 1486, 62379, 2103487}},
+    {"castle test", TestPositions::castleTestPositionFEN, {25, 625, 15206, 369906, 8826660}},
+    {"promotion test", TestPositions::promotionTestPositionFEN, {27, 681, 17552, 468341}},
+    {"stalemate test", TestPositions::stalemateTestPositionFEN, {26, 46, 1140, 4610, 117294}},
+};
+
+//One move list per ply which gets reused, so the search itself doesn't allocate.
+using PlyMoveLists = std::vector<MoveList>;
+
+static uint64_t perft(Board& board, int const depth, PlyMoveLists& plyMoves, int const ply = 0)
+{
+    auto& moves {plyMoves[ply]};
+    board.generateLegalMoves(moves);
+
+    //bulk counting. The moves at the last ply dont need to be made to be counted.
+    if(depth == 1)
+        return moves.size();
+
+    uint64_t nodes {0};
+    for(auto const& move : moves)
+    {
+        board.makeMove(move);
+        nodes += perft(board, depth - 1, plyMoves, ply + 1);
+        board.unmakeMove();
+    }
+
+    return nodes;
+}
+
+struct PerftResult
+{
+    uint64_t nodes {0};
+    double seconds {0.0};
+};
+
+static PerftResult runPerft(Board& board, std::string_view const fen, int const depth, bool const divide)
+{
+    board.setPosition(fen);
+    PlyMoveLists plyMoves(static_cast<size_t>(depth) + 1);
+
+    auto const start {std::chrono::steady_clock::now()};
+    uint64_t nodes {0};
+
+    if(divide)
+    {
+        MoveList rootMoves;
+        board.generateLegalMoves(rootMoves);
+
+        for(auto const& move : rootMoves)
+        {
+            uint64_t moveNodes {1};
+            if(depth > 1)
+            {
+                board.makeMove(move);
+                moveNodes = perft(board, depth - 1, plyMoves);
+                board.unmakeMove();
+            }
+
+            std::cout << toCoordinateNotation(move.toChessMove()) << ": " << moveNodes << '\n';
+            nodes += moveNodes;
+        }
+    }
+    else nodes = perft(board, depth, plyMoves);
+
+    std::chrono::duration<double> const elapsed {std::chrono::steady_clock::now() - start};
+    return {nodes, elapsed.count()};
+}
+
+static void printResult(int const depth, PerftResult const& result)
+{
+    auto const nps {result.seconds > 0.0 ? static_cast<uint64_t>(result.nodes / result.seconds) : 0};
+    std::cout << "depth " << depth << "  nodes " << result.nodes << "  time "
+        << static_cast<uint64_t>(result.seconds * 1000.0) << "ms  nps " << nps;
+}
+
+//Returns false if any node count didnt match the reference.
+static bool runSuite(Board& board, int const maxDepth)
+{
+    bool allPassed {true};
+    uint64_t totalNodes {0};
+    double totalSeconds {0.0};
+
+    for(auto const& ref : s_referencePositions)
+    {
+        std::cout << ref.name << " (" << ref.fen << ")\n";
+
+        for(int depth = 1; depth <= maxDepth && depth <= static_cast<int>(ref.nodes.size()); ++depth)
+        {
+            auto const result {runPerft(board, ref.fen, depth, false)};
+            auto const expected {ref.nodes[depth - 1]};
+            bool const passed {result.nodes == expected};
+
+            std::cout << "  ";
+            printResult(depth, result);
+            std::cout << (passed ? "  OK\n" : "  FAILED (expected " + std::to_string(expected) + ")\n");
+
+            allPassed = allPassed && passed;
+            totalNodes += result.nodes;
+            totalSeconds += result.seconds;
+        }
+    }
+
+    std::cout << "\ntotal nodes " << totalNodes << "  nps "
+        << (totalSeconds > 0.0 ? static_cast<uint64_t>(totalNodes / totalSeconds) : 0) << '\n'
+        << (allPassed ? "all node counts matched\n" : "SOME NODE COUNTS DID NOT MATCH\n");
+
+    return allPassed;
+}
+
+static constexpr std::string_view USAGE
+{
+    "  chess_perft                       run every reference position\n"
+    "  chess_perft suite <maxDepth>      run every reference position up to maxDepth\n"
+    "  chess_perft perft <depth> [FEN]   count the nodes from FEN (start position by default)\n"
+    "  chess_perft divide <depth> [FEN]  same as perft but prints the nodes below each root move\n"
+};
+
+int main(int argumentCount, char** argumentVector)
+{
+    HeadlessBoard board;
+
+    if(argumentCount < 2)
+        return runSuite(board, 64) ? EXIT_SUCCESS : EXIT_FAILURE;
+
+    std::string_view const command {argumentVector[1]};
+
+    if(argumentCount < 3)
+        return printUsage(USAGE);
+
+    auto const depth {parsePositiveInt(argumentVector[2])};
+    if( ! depth )
+        return printUsage(USAGE);
+
+    if(command == "suite")
+        return runSuite(board, *depth) ? EXIT_SUCCESS : EXIT_FAILURE;
+
+    if(command != "perft" && command != "divide")
+        return printUsage(USAGE);
+
+    //The FEN can be passed as one quoted argument or as its separate fields.
+    std::string fen {TestPositions::defaultPositionFEN};
+    if(argumentCount > 3)
+    {
+        fen = argumentVector[3];
+        for(int i = 4; i < argumentCount; ++i)
+            fen.append(" ").append(argumentVector[i]);
+    }
+
+    if(auto const parsed {FENCodec::parse(fen)}; ! parsed)
+    {
+        //point at where in the FEN the problem is
+        std::cerr << "invalid FEN: " << parsed.error().message << '\n' << fen << '\n'
+            << std::string(parsed.error().position, ' ') << "^\n";
+        return EXIT_FAILURE;
+    }
+
+    auto const result {runPerft(board, fen, *depth, command == "divide")};
+    printResult(*depth, result);
+
+    //If the position is one of the reference positions, check the count too.
+    for(auto const& ref : s_referencePositions)
+    {
+        if(ref.fen != fen || *depth > static_cast<int>(ref.nodes.size()))
+            continue;
+
+        auto const expected {ref.nodes[*depth - 1]};
+        if(result.nodes != expected)
+        {
+            std::cout << "  FAILED (expected " << expected << ")\n";
+            return EXIT_FAILURE;
+        }
+
+        std::cout << "  OK";
+        break;
+    }
+
+    std::cout << '\n';
+    return EXIT_SUCCESS;
+}
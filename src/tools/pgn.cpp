@@ -0,0 +1,192 @@
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <string_view>
+
+#include "Board.hpp"
+#include "MoveList.hpp"
+#include "PGN.hpp"
+#include "ToolHelpers.hpp"
+
+//Headless PGN database reader. Streams every game of a PGN file through PGNReader (so a file of any size is read
+//in constant memory), reports each move that can't be played and how fast the file was read, and can write the
+//games back out in export format.
+//
+//usage:
+//  chess_pgn <file> [out]                     reads the games in file (writing the ones without errors to out)
+//  chess_pgn generate <file> <games> [seed]   writes games of random legal moves to file, for benchmarking
+//  chess_pgn check                            reads the malformed games below, checking each is read as expected
+
+static constexpr std::string_view USAGE
+{
+    "  chess_pgn <file> [out]                    read the games in file (writing the ones without errors to out)\n"
+    "  chess_pgn generate <file> <games> [seed]  write games of random legal moves to file\n"
+    "  chess_pgn check                           read a set of malformed games, checking how each is read\n"
+};
+
+//PGN the reader has to get through without getting stuck (or reading past the end of a token), along with what
+//it should make of it. A database of millions of games is bound to have a few like these.
+struct MalformedPGN
+{
+    std::string_view name;
+    std::string_view pgn;
+    size_t numGames;
+    size_t numFirstGameMoves;
+    bool hasFirstGameError;
+};
+
+static constexpr std::array malformedPGNs
+{
+    MalformedPGN{"stray }",               "1. e4 } e5 2. Nf3 *",                        1, 3, false},
+    MalformedPGN{"stray ) and ]",         "1. e4 ) e5 ] 2. Nf3 *",                      1, 3, false},
+    MalformedPGN{"only closing brackets", "}})]",                                       0, 0, false},
+    MalformedPGN{"unclosed comment",      "1. e4 { the rest is a comment 2. d4 *",      1, 1, false},
+    MalformedPGN{"unclosed variation",    "1. e4 (1. d4 d5 2. c4 *",                    1, 1, false},
+    MalformedPGN{"unclosed tag",          "[Event \"x\n1. e4 e5 *",                     1, 2, false},
+    MalformedPGN{"no result",             "1. e4 e5\n[Event \"2\"]\n1. d4 *",           2, 2, false},
+    MalformedPGN{"illegal move",          "1. e4 e4 2. Nf3 *",                          1, 1, true},
+    MalformedPGN{"bad FEN tag",           "[FEN \"zz\"]\n1. e4 *",                      1, 0, true},
+    MalformedPGN{"empty",                 "",                                           0, 0, false},
+};
+
+static int checkMalformedPGNs()
+{
+    bool allPassed {true};
+    PGNGame game;
+
+    for(auto const& malformed : malformedPGNs)
+    {
+        std::istringstream in {std::string{malformed.pgn}};
+        PGNReader reader {in};
+
+        size_t numGames {0};
+        bool isAsExpected {true};
+        while(reader.readGame(game))
+        {
+            if(numGames++ == 0)
+                isAsExpected = game.moves.size() == malformed.numFirstGameMoves && game.error.has_value() == malformed.hasFirstGameError;
+        }
+        isAsExpected = isAsExpected && numGames == malformed.numGames;
+
+        allPassed = allPassed && isAsExpected;
+        std::cout << malformed.name << "  " << (isAsExpected ? "OK" : "FAILED") << '\n';
+    }
+
+    std::cout << (allPassed ? "every malformed game was read as expected\n" : "SOME MALFORMED GAMES WERE NOT READ AS EXPECTED\n");
+    return allPassed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+static int generatePGN(char const* const path, int const numGames, unsigned const seed)
+{
+    PGNWriter writer;
+    PGNGame game;
+    MoveList moves;
+    int round {0};
+
+    return generateGames(path, numGames, seed, [&](std::ostream& out, Board const& board)
+    {
+        game.clear();
+        game.setTag("Event", "Random game");
+        game.setTag("Round", std::to_string(++round));
+        std::ranges::copy(board.getMoveHistory(), std::back_inserter(game.moves));
+
+        //a game that ran out of legal moves before the ply limit ended in mate or stalemate
+        board.generateLegalMoves(moves);
+        if(moves.empty())
+        {
+            bool const isCheckmate {board.getCheckState() != Board::CheckType::NO_CHECK};
+            game.result = ! isCheckmate ? "1/2-1/2" : board.getWhosTurnItIs() == Side::WHITE ? "0-1" : "1-0";
+        }
+
+        writer.write(out, game);
+    });
+}
+
+static int readFile(char const* const path, char const* const outPath)
+{
+    std::ifstream file {path, std::ios::binary};
+    if( ! file )
+    {
+        std::cerr << "could not open " << path << '\n';
+        return EXIT_FAILURE;
+    }
+
+    std::ofstream out;
+    std::optional<PGNWriter> writer;
+    if(outPath)
+    {
+        out.open(outPath);
+        if( ! out )
+        {
+            std::cerr << "could not open " << outPath << '\n';
+            return EXIT_FAILURE;
+        }
+        writer.emplace();
+    }
+
+    PGNReader reader {file};
+    PGNGame game;
+
+    uint64_t numGames {0};
+    uint64_t numMoves {0};
+    uint64_t numErrors {0};
+
+    auto const start {std::chrono::steady_clock::now()};
+    while(reader.readGame(game))
+    {
+        ++numGames;
+        numMoves += game.moves.size();
+
+        if(game.error)
+        {
+            ++numErrors;
+            std::cout << "game " << numGames << "  line " << game.error->line << "  " << game.error->message
+                << "  " << game.error->token << '\n';
+            continue;
+        }
+
+        if(writer)
+            writer->write(out, game);
+    }
+    std::chrono::duration<double> const elapsed {std::chrono::steady_clock::now() - start};
+
+    double const seconds {elapsed.count()};
+    std::cout << "games " << numGames << "  moves " << numMoves << "  errors " << numErrors
+        << "  time " << static_cast<uint64_t>(seconds * 1000.0) << "ms  games/s "
+        << (seconds > 0.0 ? static_cast<uint64_t>(numGames / seconds) : 0) << "  moves/s "
+        << (seconds > 0.0 ? static_cast<uint64_t>(numMoves / seconds) : 0) << '\n';
+
+    return numErrors == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+int main(int argumentCount, char** argumentVector)
+{
+    if(argumentCount < 2)
+        return printUsage(USAGE);
+
+    if(std::string_view{argumentVector[1]} == "check")
+        return checkMalformedPGNs();
+
+    if(std::string_view{argumentVector[1]} == "generate")
+    {
+        if(argumentCount < 4)
+            return printUsage(USAGE);
+
+        auto const numGames {parsePositiveInt(argumentVector[3])};
+        auto const seed {argumentCount > 4 ? parsePositiveInt(argumentVector[4]) : std::optional<int>{1}};
+        if( ! numGames || ! seed )
+            return printUsage(USAGE);
+
+        return generatePGN(argumentVector[2], *numGames, static_cast<unsigned>(*seed));
+    }
+
+    return readFile(argumentVector[1], argumentCount > 2 ? argumentVector[2] : nullptr);
+}
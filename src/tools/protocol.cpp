@@ -0,0 +1,234 @@
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <iterator>
+#include <optional>
+#include <random>
+#include <ranges>
+#include <span>
+#include <string_view>
+#include <tuple>
+#include <vector>
+
+#include "HeadlessBoard.hpp"
+#include "ProtocolCodec.hpp"
+#include "ToolHelpers.hpp"
+
+//Headless fuzzer and benchmark for the network message codec (see ProtocolCodec.hpp).
+//The fuzzer throws random bytes at every message's decoder and checks that whatever decodes encodes back to the
+//same bytes, that headers are accepted exactly when chessNetworkProtocol.h says they should be and that real
+//moves survive the trip. The benchmark encodes a stream of move messages and frames/decodes it back again.
+//
+//usage:
+//  chess_protocol fuzz [iterations] [seed]   fuzzes the decoders (1000000 iterations by default)
+//  chess_protocol bench [messages]           encode/decode throughput (20000000 messages by default)
+
+static constexpr std::string_view USAGE
+{
+    "  chess_protocol fuzz [iterations] [seed]  fuzz the message decoders\n"
+    "  chess_protocol bench [messages]          measure encode/decode throughput\n"
+};
+
+//Legal moves from random games, so the move messages are ones the client would really send.
+static std::vector<PackedMove> getRandomGameMoves(size_t const numMoves, std::mt19937& rng)
+{
+    HeadlessBoard board;
+    std::vector<PackedMove> moves;
+
+    while(moves.size() < numMoves)
+    {
+        playRandomGame(board, rng);
+        std::ranges::copy(board.getMoveHistory() | std::views::take(numMoves - moves.size()), std::back_inserter(moves));
+    }
+
+    return moves;
+}
+
+//Anything Msg's decoder accepts has to encode back to exactly the same bytes.
+template<ProtocolCodec::Message Msg>
+static bool roundTrips(std::span<std::byte const> const bytes)
+{
+    auto const msg {ProtocolCodec::decode<Msg>(bytes)};
+    if( ! msg )
+        return true;
+
+    auto const encoded {ProtocolCodec::encode(*msg)};
+    return std::ranges::equal(encoded, bytes);
+}
+
+static int fuzz(uint64_t const iterations, uint32_t const seed)
+{
+    std::mt19937 rng {seed};
+    uint64_t numFailures {0};
+    uint64_t numValidHeaders {0};
+    uint64_t numValidMoves {0};
+
+    auto const fail = [&numFailures](std::string_view what, std::span<std::byte const> bytes)
+    {
+        if(++numFailures > 10)
+            return;
+
+        std::cout << what << ':';
+        for(auto const b : bytes)
+            std::cout << ' ' << std::to_integer<int>(b);
+        std::cout << '\n';
+    };
+
+    std::array<std::byte, 16> buffer {};
+    for(uint64_t i = 0; i < iterations; ++i)
+    {
+        //mostly real headers with random payloads, so the decoders get past their header checks.
+        //Half of the payloads are small numbers, which is what a move message is made of.
+        size_t const size {std::uniform_int_distribution<size_t>{0, buffer.size()}(rng)};
+        uint32_t const payloadMod {rng() % 2 ? 256u : 10u};
+        for(auto& b : buffer)
+            b = static_cast<std::byte>(rng() % payloadMod);
+
+        if(rng() % 4 != 0)
+        {
+            auto const msgType {static_cast<uint8_t>(rng() % (static_cast<uint32_t>(MessageType::NEW_ID_MSGTYPE) + 1))};
+            buffer[0] = static_cast<std::byte>(msgType);
+            buffer[1] = static_cast<std::byte>(rng() % 8 != 0 ? ProtocolCodec::getMessageSize(static_cast<MessageType>(msgType)) : size);
+        }
+
+        std::span<std::byte const> const bytes {buffer.data(), size};
+
+        bool const isValidHeader {ProtocolCodec::isValidHeader(buffer[0], buffer[1])};
+        auto const expectedSize {ProtocolCodec::getMessageSize(static_cast<MessageType>(buffer[0]))};
+        if(isValidHeader != (expectedSize != 0 && std::to_integer<uint8_t>(buffer[1]) == expectedSize))
+            fail("isValidHeader() disagrees with chessNetworkProtocol.h", {buffer.data(), 2});
+        numValidHeaders += isValidHeader;
+
+        bool const allRoundTrip {std::apply([bytes]<typename... Msgs>(Msgs...)
+        {
+            return (roundTrips<Msgs>(bytes) && ...);
+        }, ProtocolCodec::AllMessages{})};
+        if( ! allRoundTrip )
+            fail("decoded message doesn't encode back to the same bytes", bytes);
+
+        //a move message that decodes has to come back out as the same move
+        if(auto const move {ProtocolCodec::decodeMoveMessage(bytes)})
+        {
+            ++numValidMoves;
+            if(ProtocolCodec::decodeMoveMessage(ProtocolCodec::encodeMoveMessage(*move)) != move)
+                fail("move doesn't survive being encoded again", bytes);
+        }
+    }
+
+    for(auto const move : getRandomGameMoves(100000, rng))
+    {
+        auto const msg {ProtocolCodec::encodeMoveMessage(move)};
+        if(ProtocolCodec::decodeMoveMessage(msg) != move)
+            fail("legal move doesn't survive being encoded", msg);
+    }
+
+    std::cout << "iterations " << iterations << "  valid headers " << numValidHeaders
+        << "  valid moves " << numValidMoves << "  failures " << numFailures << '\n';
+
+    return numFailures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+static double getSecondsSince(std::chrono::steady_clock::time_point const start)
+{
+    return std::chrono::duration<double>{std::chrono::steady_clock::now() - start}.count();
+}
+
+static void printRate(std::string_view const what, uint64_t const numMessages, size_t const numBytes, double const seconds)
+{
+    std::cout << what << ' ' << static_cast<uint64_t>(seconds * 1000.0) << "ms  messages/s "
+        << (seconds > 0.0 ? static_cast<uint64_t>(numMessages / seconds) : 0) << "  MB/s "
+        << (seconds > 0.0 ? static_cast<uint64_t>(numBytes / seconds / 1e6) : 0) << '\n';
+}
+
+static int bench(uint64_t const numMessages)
+{
+    std::mt19937 rng {1};
+    auto const moves {getRandomGameMoves(4096, rng)};
+
+    //one message in every four is a pair request, so both the byte and uint32 fields are measured
+    constexpr size_t messagesPerRound {4};
+    constexpr size_t roundSize {3 * sizeof(ProtocolCodec::MoveMessage) + ProtocolCodec::ENCODED_SIZE<ProtocolCodec::PairRequestMsg>};
+    uint64_t const numRounds {(numMessages + messagesPerRound - 1) / messagesPerRound};
+
+    std::vector<std::byte> stream(numRounds * roundSize);
+
+    auto start {std::chrono::steady_clock::now()};
+    std::byte* out {stream.data()};
+    for(uint64_t i = 0; i < numRounds; ++i)
+    {
+        for(size_t j = 0; j < 3; ++j)
+        {
+            auto const msg {ProtocolCodec::encode(ProtocolCodec::toMoveMsg(moves[(i * 3 + j) & (moves.size() - 1)]))};
+            out = std::ranges::copy(msg, out).out;
+        }
+
+        auto const msg {ProtocolCodec::encode(ProtocolCodec::PairRequestMsg{static_cast<uint32_t>(i)})};
+        out = std::ranges::copy(msg, out).out;
+    }
+    printRate("encode", numRounds * messagesPerRound, stream.size(), getSecondsSince(start));
+
+    //framed the same way ConnectionManager::processNetworkMessages() does it
+    uint64_t checksum {0};
+    uint64_t numDecoded {0};
+    start = std::chrono::steady_clock::now();
+    for(std::span<std::byte const> bytes {stream}; bytes.size() >= ProtocolCodec::HEADER_SIZE; )
+    {
+        size_t const size {std::to_integer<size_t>(bytes[1])};
+        if( ! ProtocolCodec::isValidHeader(bytes[0], bytes[1]) || size > bytes.size() )
+        {
+            std::cerr << "bad message at byte " << stream.size() - bytes.size() << '\n';
+            return EXIT_FAILURE;
+        }
+
+        if(bytes[0] == static_cast<std::byte>(MessageType::MOVE_MSGTYPE))
+        {
+            auto const msg {ProtocolCodec::decodeUnchecked<ProtocolCodec::MoveMsg>(bytes.first<sizeof(ProtocolCodec::MoveMessage)>())};
+            checksum += ProtocolCodec::toPackedMove(msg).value_or(PackedMove{}).getBits();
+        }
+        else
+        {
+            checksum += ProtocolCodec::decodeUnchecked<ProtocolCodec::PairRequestMsg>(
+                bytes.first<ProtocolCodec::ENCODED_SIZE<ProtocolCodec::PairRequestMsg>>()).id;
+        }
+
+        ++numDecoded;
+        bytes = bytes.subspan(size);
+    }
+    printRate("decode", numDecoded, stream.size(), getSecondsSince(start));
+
+    std::cout << "checksum " << checksum << '\n';
+    return EXIT_SUCCESS;
+}
+
+int main(int argumentCount, char** argumentVector)
+{
+    if(argumentCount < 2)
+        return printUsage(USAGE);
+
+    std::string_view const command {argumentVector[1]};
+
+    //the count (iterations or messages) can be left out but has to be a positive number if it is given
+    auto const getCount = [&](uint64_t const defaultCount)
+    {
+        return argumentCount > 2 ? parsePositiveInt<uint64_t>(argumentVector[2]) : std::optional<uint64_t>{defaultCount};
+    };
+
+    if(command == "fuzz")
+    {
+        auto const iterations {getCount(1000000)};
+        auto const seed {argumentCount > 3 ? parsePositiveInt<uint64_t>(argumentVector[3]) : std::optional<uint64_t>{1}};
+        if(iterations && seed)
+            return fuzz(*iterations, static_cast<uint32_t>(*seed));
+    }
+    else if(command == "bench")
+    {
+        if(auto const numMessages {getCount(20000000)}; numMessages)
+            return bench(*numMessages);
+    }
+
+    return printUsage(USAGE);
+}
@@ -0,0 +1,75 @@
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include "EngineSettings.hpp"
+#include "FENCodec.hpp"
+#include "LazySMP.hpp"
+#include "TestPositions.hpp"
+#include "ToolHelpers.hpp"
+#include "TranspositionTable.hpp"
+
+//Headless search tool for the analysis machines. Runs the engine's LazySMP search on a position
+//and reports the best move along with the nodes searched by each thread and the total nodes per second.
+//The thread count and the transposition table size come from engineSettings.txt, same as the app.
+//
+//usage:
+//  chess_search <milliseconds> [FEN]   searches FEN (the start position if no FEN is given) for the given time
+
+static constexpr std::string_view USAGE
+{
+    "  chess_search <milliseconds> [FEN]  search FEN (start position by default) for the given time\n"
+};
+
+int main(int argumentCount, char** argumentVector)
+{
+    if(argumentCount < 2)
+        return printUsage(USAGE);
+
+    auto const ms {parsePositiveInt(argumentVector[1])};
+    if( ! ms )
+        return printUsage(USAGE);
+
+    //The FEN can be passed as one quoted argument or as its separate fields.
+    std::string fen {TestPositions::defaultPositionFEN};
+    if(argumentCount > 2)
+    {
+        fen = argumentVector[2];
+        for(int i = 3; i < argumentCount; ++i)
+            fen.append(" ").append(argumentVector[i]);
+    }
+
+    if(auto const parsed {FENCodec::parse(fen)}; ! parsed)
+    {
+        //point at where in the FEN the problem is
+        std::cerr << "invalid FEN: " << parsed.error().message << '\n' << fen << '\n'
+            << std::string(parsed.error().position, ' ') << "^\n";
+        return EXIT_FAILURE;
+    }
+
+    auto const settings {EngineSettings::load()};
+    TranspositionTable transpositionTable {settings.hashSizeMB};
+    LazySMP search {transpositionTable, settings.numThreads};
+
+    std::cout << fen << "\nthreads " << search.getNumThreads() << "  hash " << transpositionTable.getSizeInMB() << "MB\n";
+
+    search.setPosition(fen, {});
+    auto const result {search.run({.maxTime = std::chrono::milliseconds{*ms}})};
+    auto const& best {result.mainThreadResult};
+
+    for(size_t i = 0; i < result.nodesPerThread.size(); ++i)
+        std::cout << "  thread " << i << "  nodes " << result.nodesPerThread[i] << '\n';
+
+    std::cout << "bestmove " << ( ! best.bestMove ? "none" : toCoordinateNotation(best.bestMove.toChessMove()))
+        << "  score " << best.score << "  depth " << best.depth
+        << "\nnodes " << result.totalNodes << "  time " << static_cast<uint64_t>(result.seconds * 1000.0)
+        << "ms  nps " << result.getNodesPerSecond()
+        << "  tt hit rate " << static_cast<int>(result.getTTHitRate() * 100.0) << "%"
+        << "  tt full " << transpositionTable.getPermillFull() << " permill\n";
+
+    return EXIT_SUCCESS;
+}
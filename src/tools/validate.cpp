@@ -0,0 +1,152 @@
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <span>
+#include <string_view>
+#include <thread>
+
+#include "Board.hpp"
+#include "GameValidator.hpp"
+#include "MappedFile.hpp"
+#include "ProtocolCodec.hpp"
+#include "ToolHelpers.hpp"
+
+//Headless game validator for the server. Splits a recorded stream of protocol messages into games
+//(see GameValidator::parseMessageStream()), replays every game on its own Board across a pool of threads
+//and reports each illegal move it finds along with how many games per second were checked.
+//
+//A PGN file can be validated the same way, its games read by PGNReader (see GameValidator::parsePGN()).
+//
+//usage:
+//  chess_validate <file> [threads]                 validates the games in file (every core by default)
+//  chess_validate pgn <file> [threads]             validates the games in a PGN file
+//  chess_validate generate <file> <games> [seed]   writes games of random legal moves to file, for benchmarking
+
+static constexpr std::string_view USAGE
+{
+    "  chess_validate <file> [threads]                validate the games in file (every core by default)\n"
+    "  chess_validate pgn <file> [threads]            validate the games in a PGN file\n"
+    "  chess_validate generate <file> <games> [seed]  write games of random legal moves to file\n"
+};
+
+//Each game is a REMATCH_ACCEPT message followed by a MOVE message for each of its moves.
+static int generateMessageStream(char const* const path, int const numGames, unsigned const seed)
+{
+    auto const writeBytes = [](std::ostream& out, std::span<std::byte const> const bytes)
+    {
+        out.write(reinterpret_cast<char const*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+    };
+
+    return generateGames(path, numGames, seed, [&](std::ostream& out, Board const& board)
+    {
+        writeBytes(out, ProtocolCodec::encode(ProtocolCodec::RematchAcceptMsg{}));
+        for(auto const move : board.getMoveHistory())
+            writeBytes(out, ProtocolCodec::encodeMoveMessage(move));
+    });
+}
+
+static int validate(std::span<RecordedGame const> const games, int const numThreads)
+{
+    auto const start {std::chrono::steady_clock::now()};
+    auto const results {GameValidator::validateGames(games, numThreads)};
+    std::chrono::duration<double> const elapsed {std::chrono::steady_clock::now() - start};
+
+    size_t numIllegal {0};
+    size_t numBadFENs {0};
+    uint64_t numMoves {0};
+    for(size_t i = 0; i < games.size(); ++i)
+    {
+        numMoves += games[i].moves.size();
+        if( ! results[i] )
+            continue;
+
+        auto const& error {*results[i]};
+        if(error.type == GameError::Type::BAD_FEN)
+        {
+            ++numBadFENs;
+            std::cout << "game " << i << "  bad starting FEN  " << error.fenError.message
+                << " at character " << error.fenError.position << "  " << games[i].startingFEN << '\n';
+            continue;
+        }
+
+        ++numIllegal;
+        auto const move {games[i].moves[error.moveIdx]};
+        std::cout << "game " << i << "  illegal move " << error.moveIdx + 1 << "  "
+            << ( ! move ? "(malformed)" : toCoordinateNotation(move.toChessMove())) << '\n';
+    }
+
+    double const seconds {elapsed.count()};
+    std::cout << "games " << games.size() << "  moves " << numMoves << "  illegal " << numIllegal
+        << "  bad FENs " << numBadFENs << "  threads " << numThreads << "  time " << static_cast<uint64_t>(seconds * 1000.0) << "ms  games/s "
+        << (seconds > 0.0 ? static_cast<uint64_t>(games.size() / seconds) : 0) << '\n';
+
+    return numIllegal == 0 && numBadFENs == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+//isPGN picks between a PGN file and a recorded stream of protocol messages.
+static int validateFile(char const* const path, bool const isPGN, int const numThreads)
+{
+    if(isPGN)
+    {
+        std::ifstream file {path, std::ios::binary};
+        if( ! file )
+        {
+            std::cerr << "could not open " << path << '\n';
+            return EXIT_FAILURE;
+        }
+
+        return validate(GameValidator::parsePGN(file), numThreads);
+    }
+
+    //mapped rather than read in, so a stream of any size isn't copied into memory first
+    auto const stream {MappedFile::open(path)};
+    if( ! stream )
+    {
+        std::cerr << stream.error() << '\n';
+        return EXIT_FAILURE;
+    }
+
+    stream->adviseSequential();
+    return validate(GameValidator::parseMessageStream(stream->getBytes()), numThreads);
+}
+
+int main(int argumentCount, char** argumentVector)
+{
+    if(argumentCount < 2)
+        return printUsage(USAGE);
+
+    std::string_view const command {argumentVector[1]};
+
+    if(command == "generate")
+    {
+        if(argumentCount < 4)
+            return printUsage(USAGE);
+
+        auto const numGames {parsePositiveInt(argumentVector[3])};
+        auto const seed {argumentCount > 4 ? parsePositiveInt(argumentVector[4]) : 1};
+        if( ! numGames || ! seed )
+            return printUsage(USAGE);
+
+        return generateMessageStream(argumentVector[2], *numGames, static_cast<unsigned>(*seed));
+    }
+
+    //chess_validate pgn <file> [threads] takes the same arguments as chess_validate <file> [threads], one further along
+    bool const isPGN {command == "pgn"};
+    int const pathIdx {isPGN ? 2 : 1};
+    if(argumentCount <= pathIdx)
+        return printUsage(USAGE);
+
+    auto const numThreads
+    {
+        argumentCount > pathIdx + 1 ? parsePositiveInt(argumentVector[pathIdx + 1])
+            : std::max(1, static_cast<int>(std::thread::hardware_concurrency()))
+    };
+    if( ! numThreads )
+        return printUsage(USAGE);
+
+    return validateFile(argumentVector[pathIdx], isPGN, *numThreads);
+}